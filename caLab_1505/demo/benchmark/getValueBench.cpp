@@ -0,0 +1,261 @@
+// Read throughput of getValue with 1, 2, 4 and 8 concurrent callers
+// Runs without LabVIEW: the LabVIEW memory manager functions used by libcalab are provided here.
+//
+// Start the demo IOC:
+//    softIoc -D softIoc.dbd -d demo/db/demo.db
+// Build (libcalab.so built as described in buildCaLabAtUbuntu.txt):
+//    g++ -std=c++11 -O2 -rdynamic getValueBench.cpp -o getValueBench -L/usr/local/calab -lcalab -ldl -lpthread
+// Run (from caLab_1505):
+//    demo/benchmark/getValueBench [path of demo.db] [seconds per measurement]
+// Every caller reads all waveform records of demo.db in a loop, like parallel CaLabGet VIs.
+
+#include <atomic>
+#include <chrono>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define MAX_CALLERS         8              // highest number of concurrent callers
+#define DEFAULT_DB          "demo/db/demo.db" // default database with the waveform records to read
+#define DEFAULT_SECONDS     5              // default duration of each measurement
+#define TIMEOUT             3              // seconds to wait for values of first call
+
+typedef int32_t int32;
+typedef uint32_t uInt32;
+typedef uint8_t uChar;
+typedef uint8_t LVBoolean;
+typedef int32_t MgErr;
+typedef uint32_t LVUserEventRef;
+typedef uChar **UHandle;
+enum { iB = 1, iW, iL, iQ, uB, uW, uL, uQ, fS, fD, fX };
+
+typedef struct { int32 cnt; uChar str[1]; } LStr, *LStrPtr, **LStrHandle;
+typedef struct { size_t dimSize; LStrHandle elt[1]; } sStringArray, **sStringArrayHdl;
+typedef struct { size_t dimSize; uint64_t elt[1]; } sLongArray, **sLongArrayHdl;
+typedef struct { size_t dimSize; double elt[1]; } sDoubleArray, **sDoubleArrayHdl;
+typedef struct { uInt32 dimSizes[2]; double elt[1]; } sDoubleArray2D, **sDoubleArray2DHdl;
+typedef struct { LVBoolean status; uInt32 code; LStrHandle source; } sError;
+typedef struct {
+	LStrHandle PVName;
+	uInt32 valueArraySize;
+	sStringArrayHdl StringValueArray;
+	sDoubleArrayHdl ValueNumberArray;
+	LStrHandle StatusString;
+	int16_t StatusNumber;
+	LStrHandle SeverityString;
+	int16_t SeverityNumber;
+	LStrHandle TimeStampString;
+	uInt32 TimeStampNumber;
+	sStringArrayHdl FieldNameArray;
+	sStringArrayHdl FieldValueArray;
+	sError ErrorIO;
+} sResult;
+typedef struct { size_t dimSize; sResult result[1]; } sResultArray, **sResultArrayHdl;
+
+extern "C" void getValue(sStringArrayHdl *PvNameArray, sStringArrayHdl *FieldNameArray, sLongArrayHdl *PvIndexArray, double Timeout, sResultArrayHdl *ResultArray, sStringArrayHdl *FirstStringValue, sDoubleArrayHdl *FirstDoubleValue, sDoubleArray2DHdl *DoubleValueArray, LVBoolean *CommunicationStatus, LVBoolean *FirstCall, LVBoolean *NoMDEL, LVBoolean *IsInitialized, void *ByteValueArray, void *WordValueArray, void *IntValueArray, void *FloatValueArray, void *LongValueArray);
+
+// LabVIEW memory manager
+// a handle points to the data pointer of a block which also keeps the size
+struct block {
+	size_t		size;
+	void*		data;
+};
+
+static block* blockOf(void* handle) {
+	return (block*)((char*)handle - offsetof(block, data));
+}
+
+static UHandle newHandle(size_t size) {
+	block* current = (block*)malloc(sizeof(block));
+	current->size = size;
+	current->data = calloc(1, size ? size : 1);
+	return (UHandle)&current->data;
+}
+
+static size_t elementSize(int32 type) {
+	switch (type) {
+	case iB: case uB: return 1;
+	case iW: case uW: return 2;
+	case iL: case uL: case fS: return 4;
+	default: return 8;
+	}
+}
+
+extern "C" {
+UHandle DSNewHClr(size_t size) {
+	return newHandle(size);
+}
+
+UHandle DSNewHandle(size_t size) {
+	return newHandle(size);
+}
+
+MgErr DSDisposeHandle(void* handle) {
+	if (!handle)
+		return 1;
+	block* current = blockOf(handle);
+	free(current->data);
+	free(current);
+	return 0;
+}
+
+MgErr DSCheckHandle(void* handle) {
+	return handle ? 0 : 1;
+}
+
+MgErr DSCheckPtr(void* pointer) {
+	return pointer ? 0 : 1;
+}
+
+int32 DSGetHandleSize(void* handle) {
+	return handle ? (int32)blockOf(handle)->size : 0;
+}
+
+MgErr DSSetHandleSize(void* handle, size_t size) {
+	block* current = blockOf(handle);
+	void* tmp = realloc(current->data, size ? size : 1);
+	if (!tmp)
+		return 2;
+	current->data = tmp;
+	if (size > current->size)
+		memset((char*)current->data + current->size, 0, size - current->size);
+	current->size = size;
+	return 0;
+}
+
+MgErr DSCopyHandle(void* target, const void* source) {
+	if (!source)
+		return 1;
+	block* from = blockOf((void*)source);
+	if (!*(void**)target)
+		*(UHandle*)target = newHandle(from->size);
+	else
+		DSSetHandleSize(*(void**)target, from->size);
+	memcpy(**(void***)target, from->data, from->size);
+	return 0;
+}
+
+MgErr NumericArrayResize(int32 type, int32 numDims, UHandle* handle, size_t size) {
+	size_t element = elementSize(type);
+	size_t header = numDims * sizeof(int32);
+	if (header % element)
+		header += element - header % element;
+	if (!*handle)
+		*handle = newHandle(header + size * element);
+	else
+		return DSSetHandleSize(*handle, header + size * element);
+	return 0;
+}
+
+MgErr PostLVUserEvent(LVUserEventRef ref, void* data) {
+	return 0;
+}
+
+MgErr DbgPrintfv(const char* format, va_list args) {
+	return 0;
+}
+}
+
+// names of all waveform records of a database
+//    path: database file
+static std::vector<std::string> waveforms(const char* path) {
+	std::vector<std::string> names;
+	char line[256];
+	char name[128];
+	FILE* db = fopen(path, "r");
+	if (!db)
+		return names;
+	while (fgets(line, sizeof(line), db)) {
+		if (sscanf(line, " record ( waveform , \"%127[^\"]\"", name) == 1)
+			names.push_back(name);
+	}
+	fclose(db);
+	return names;
+}
+
+// LV string array of PV names
+static sStringArrayHdl newNames(const std::vector<std::string>& pvs) {
+	int32 size;
+	sStringArrayHdl names = (sStringArrayHdl)DSNewHClr(sizeof(size_t) + pvs.size() * sizeof(LStrHandle));
+	(*names)->dimSize = pvs.size();
+	for (size_t i = 0; i < pvs.size(); i++) {
+		size = (int32)pvs[i].size();
+		NumericArrayResize(uB, 1, (UHandle*)&(*names)->elt[i], size);
+		(*(*names)->elt[i])->cnt = size;
+		memcpy((*(*names)->elt[i])->str, pvs[i].c_str(), size);
+	}
+	return names;
+}
+
+// one caller (CaLabGet VI) with its own LV data
+struct caller {
+	sStringArrayHdl		names = 0x0;
+	sStringArrayHdl		fields = 0x0;
+	sLongArrayHdl		index = 0x0;
+	sResultArrayHdl		result = 0x0;
+	sStringArrayHdl		firstString = 0x0;
+	sDoubleArrayHdl		firstDouble = 0x0;
+	sDoubleArray2DHdl	values = 0x0;
+	LVBoolean			status = 0;
+	LVBoolean			firstCall = 1;
+	LVBoolean			noMDEL = 0;
+	LVBoolean			isInitialized = 0;
+
+	void read() {
+		getValue(&names, &fields, &index, TIMEOUT, &result, &firstString, &firstDouble, &values, &status, &firstCall, &noMDEL, &isInitialized, 0x0, 0x0, 0x0, 0x0, 0x0);
+		firstCall = 0;
+	}
+};
+
+int main(int argc, char** argv) {
+	std::vector<std::string> names = waveforms(argc > 1 ? argv[1] : DEFAULT_DB);
+	double seconds = argc > 2 ? atof(argv[2]) : DEFAULT_SECONDS;
+	size_t pvs = names.size();
+	if (!pvs) {
+		fprintf(stderr, "no waveform records in %s\n", argc > 1 ? argv[1] : DEFAULT_DB);
+		return 1;
+	}
+	printf("%zu waveform records\n", pvs);
+	std::vector<caller> callers(MAX_CALLERS);
+	for (uInt32 i = 0; i < MAX_CALLERS; i++) {
+		callers[i].names = newNames(names);
+		// LabVIEW passes empty arrays as allocated handles with dimSize 0
+		callers[i].fields = (sStringArrayHdl)DSNewHClr(sizeof(size_t));
+		callers[i].index = (sLongArrayHdl)DSNewHClr(sizeof(size_t));
+		callers[i].read();
+	}
+	if (callers[0].status) {
+		fprintf(stderr, "not all PVs connected, is the demo IOC (demo/db/demo.db) running?\n");
+	}
+	printf("callers  calls/s     PVs/s       us/call\n");
+	for (uInt32 threads = 1; threads <= MAX_CALLERS; threads *= 2) {
+		std::atomic<bool> running(true);
+		std::vector<uint64_t> calls(threads, 0);
+		std::vector<std::thread> workers;
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (uInt32 t = 0; t < threads; t++) {
+			workers.push_back(std::thread([&, t] {
+				while (running) {
+					callers[t].read();
+					calls[t]++;
+				}
+			}));
+		}
+		std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+		running = false;
+		for (uInt32 t = 0; t < threads; t++)
+			workers[t].join();
+		double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		uint64_t total = 0;
+		for (uInt32 t = 0; t < threads; t++)
+			total += calls[t];
+		printf("%7u  %-10.0f  %-10.0f  %.1f\n", threads, total / elapsed, total * pvs / elapsed, total ? elapsed * threads * 1e6 / total : 0);
+	}
+	return 0;
+}
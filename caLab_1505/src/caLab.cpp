@@ -1,6 +1,8 @@
 #include <extcode.h>
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <cmath>
 #include <csignal>
 #include <ctime>
 #include <stdarg.h>
@@ -11,6 +13,17 @@
 #include <time.h>
 #include <vector>
 #include <map>
+#include <memory>
+#include <deque>
+#include <limits>
+#if defined __AVX2__
+#include <immintrin.h>
+#define CALAB_AVX2
+#endif
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CALAB_SSE2
+#endif
 
 #include <epicsVersion.h>
 #include <dbDefs.h>
@@ -20,6 +33,7 @@
 #include <alarmString.h>
 #include <cadef.h>
 #include <envDefs.h>
+#include <epicsEvent.h>
 #include <epicsStdio.h>
 #include <io.h>
 #define EXPORT __declspec(dllexport)
@@ -37,6 +51,58 @@ void* comLibHandle = 0x0;
 #define CALAB_VERSION       "1.6.0.10"
 #define ERROR_OFFSET        7000           // User defined error codes of LabVIEW start at this number
 #define MAX_ERROR_SIZE		255
+#define RECONNECT_DELAY     10             // seconds between first attempts to recreate a missing channel
+#define MAX_RECONNECT_DELAY 600            // default upper limit of doubled reconnect delays in seconds (CALAB_MAX_RECONNECT_DELAY)
+#define BATCH_SIZE          500            // default number of subscriptions per flush (CALAB_BATCH_SIZE)
+#define PUT_QUEUE_SIZE      1024           // default capacity of asynchronous put queue (CALAB_PUT_QUEUE_SIZE)
+#define DISPATCH_QUEUE_SIZE 4096           // capacity of queue of data objects with pending user events
+#define BATCH_EVENT_RATE    10             // default number of batched user events per second (addBatchEvent)
+#define PAYLOAD_VALUES      0x01           // event payload: ValueNumberArray and valueArraySize (addEventEx)
+#define PAYLOAD_STATUS      0x02           // event payload: StatusNumber
+#define PAYLOAD_SEVERITY    0x04           // event payload: SeverityNumber
+#define PAYLOAD_TIMESTAMP   0x08           // event payload: TimeStampNumber
+#define PAYLOAD_ERROR       0x10           // event payload: ErrorIO code and status
+#define PAYLOAD_STRINGS     0x20           // event payload: all strings and field arrays (full cluster like addEvent)
+#define PAYLOAD_FULL        0x3F           // event payload of addEvent
+#define MIN_BUFFER_SIZE     64             // smallest size class of write buffers in bytes
+#define BUFFER_CLASSES      20             // number of size classes of write buffers (MIN_BUFFER_SIZE * 2^n)
+#define MAX_FREE_BUFFERS    64             // released write buffers kept per size class
+#define MAX_FREE_PUTS       1024           // released asynchronous puts kept for reuse
+#define DELIVERY_OUTPUTS    9              // number of output handles of getValue checked for incremental updates
+#define MAX_DELIVERY_STATES 4096           // number of getValue callers with kept delivery state
+
+// jobs of caTask (bit mask per data object)
+#define JOB_CREATE          0x01           // create channel identifier
+#define JOB_SUBSCRIBE       0x02           // subscribe channel
+#define JOB_UNSUBSCRIBE     0x04           // unsubscribe channel
+#define JOB_WATCH           0x08           // arm timer for recreating a missing channel
+#define JOB_GET             0x10           // read value once (polling)
+
+// results of posting an LV user event (postEvent)
+#define POST_DONE           0              // event posted
+#define POST_SKIPPED        1              // event not posted, subscriber is kept (out of memory)
+#define POST_FAILED         2              // event not posted, subscriber is removed
+
+// columns of statistics array in info (one row per PV)
+#define STAT_RETRIES        0              // number of attempts to recreate channel since last connect
+#define STAT_MISSING        1              // 1 = PV is known as missing (negative cache), 0 = otherwise
+#define STAT_PUTS_SENT      2              // number of puts issued to Channel Access
+#define STAT_PUTS_COALESCED 3              // number of queued puts replaced by newer values (CALAB_COALESCE_PUTS)
+#define STAT_EVENTS_POSTED  4              // number of LV user events posted
+#define STAT_EVENTS_COALESCED 5            // number of updates merged into a later LV user event (dispatch queue or rate limit)
+#define STAT_EVENTS_DROPPED 6              // number of LV user events which could not be posted
+#define STAT_UPDATES        7              // number of value updates received
+#define STAT_BYTES          8              // number of bytes of value updates received
+#define STAT_CALLBACK_LAST  9              // duration of last value callback in seconds
+#define STAT_CALLBACK_MAX   10             // longest value callback in seconds
+#define STAT_INTERVAL_MEAN  11             // mean seconds between value updates
+#define STAT_INTERVAL_JITTER 12            // standard deviation of seconds between value updates
+#define STAT_CONNECTS       13             // number of connects
+#define STAT_DISCONNECTS    14             // number of disconnects
+#define STAT_FIRST_VALUE    15             // seconds from creating channel to first value (-1 = no value yet)
+#define STAT_PUT_LATENCY_LAST 16           // seconds from last put with callback to its completion
+#define STAT_PUT_LATENCY_MAX 17            // longest put with callback in seconds
+#define STAT_COLUMNS        18             // number of columns
 
 #ifndef __GNUC__
 #pragma warning(push)
@@ -86,6 +152,30 @@ typedef struct {
 } sDoubleArray2D;
 typedef sDoubleArray2D **sDoubleArray2DHdl;
 
+typedef struct {
+	uInt32 dimSizes[2];
+	int8 elt[1];
+} sByteArray2D;
+typedef sByteArray2D **sByteArray2DHdl;
+
+typedef struct {
+	uInt32 dimSizes[2];
+	int16 elt[1];
+} sWordArray2D;
+typedef sWordArray2D **sWordArray2DHdl;
+
+typedef struct {
+	uInt32 dimSizes[2];
+	int32 elt[1];
+} sIntArray2D;
+typedef sIntArray2D **sIntArray2DHdl;
+
+typedef struct {
+	uInt32 dimSizes[2];
+	float32 elt[1];
+} sFloatArray2D;
+typedef sFloatArray2D **sFloatArray2DHdl;
+
 typedef struct {
 	size_t dimSize;
 	uInt32 elt[1];
@@ -140,6 +230,26 @@ typedef struct {
 	sResult result[1];
 } sResultArray;
 typedef sResultArray **sResultArrayHdl;
+
+typedef struct {
+	LStrHandle PVName;                 // name of written PV
+	sError ErrorIO;                    // completion status of put
+} sPutResult;
+
+typedef struct {
+	uInt32 Index;                      // index of PV in PvNameArray of addBatchEvent
+	sDoubleArrayHdl ValueNumberArray;  // values as double array
+	int16_t StatusNumber;              // status of PV as short
+	int16_t SeverityNumber;            // severity of PV as short
+	uInt32 TimeStampNumber;            // time stamp of PV as integer
+	uInt32 ErrorCode;                  // error code (0 = no error)
+} sBatchEntry;
+
+typedef struct {
+	size_t dimSize;
+	sBatchEntry elt[1];
+} sBatchArray;
+typedef sBatchArray **sBatchArrayHdl;
 #include "lv_epilog.h"
 
 #if defined WIN32 || defined WIN64
@@ -201,6 +311,8 @@ const char * epicsAlarmConditionStrings[] = {
 #define ECA_BADTYPE                DEFMSG(CA_K_ERROR,   14)
 #define ECA_DISCONN                DEFMSG(CA_K_WARNING, 24)
 #define ECA_UNRESPTMO              DEFMSG(CA_K_WARNING,   60)
+#define ECA_TIMEOUT                DEFMSG(CA_K_WARNING, 10)
+#define ECA_PUTFAIL                DEFMSG(CA_K_WARNING, 20)
 #define DBE_VALUE                  (1<<0)
 #define DBE_ALARM                  (1<<2)
 #define DBF_STRING                 0
@@ -212,6 +324,7 @@ const char * epicsAlarmConditionStrings[] = {
 #define	DBF_LONG                   5
 #define	DBF_DOUBLE                 6
 #define DBF_NO_ACCESS              7
+#define TYPENOTCONN                (-1)
 #define DBR_STRING	DBF_STRING
 #define	DBR_INT		DBF_INT
 #define	DBR_SHORT	DBF_INT
@@ -305,6 +418,7 @@ typedef struct oldChannelNotify *chid;
 typedef struct oldSubscription  *evid;
 typedef struct epicsMutexParm *epicsMutexId;
 typedef struct epicsThreadOSD *epicsThreadId;
+typedef struct epicsEventOSD *epicsEventId;
 typedef chid chanId;
 typedef uint8_t epicsUInt8;
 typedef int16_t epicsInt16;
@@ -325,6 +439,8 @@ typedef enum { ca_disable_preemptive_callback, ca_enable_preemptive_callback } c
 typedef enum { epicsThreadStackSmall, epicsThreadStackMedium, epicsThreadStackBig } epicsThreadStackSizeClass;
 typedef enum { cs_never_conn, cs_prev_conn, cs_conn, cs_closed } channel_state;
 typedef enum { epicsMutexLockOK, epicsMutexLockTimeout, epicsMutexLockError } epicsMutexLockStatus;
+typedef enum { epicsEventEmpty, epicsEventFull } epicsEventInitialState;
+typedef enum { epicsEventWaitOK, epicsEventWaitTimeout, epicsEventWaitError } epicsEventWaitStatus;
 typedef struct epicsTimeStamp {
 	epicsUInt32    secPastEpoch;
 	epicsUInt32    nsec;
@@ -398,9 +514,12 @@ typedef const unsigned short(*dbr_value_offset_t);
 typedef epicsMutexId(*epicsMutexOsiCreate_t)(const char *pFileName, int lineno);
 typedef epicsThreadId(*epicsThreadCreate_t) (const char * name, unsigned int priority, unsigned int stackSize, EPICSTHREADFUNC funptr, void * parm);
 typedef epicsMutexLockStatus(*epicsMutexTryLock_t)(epicsMutexId id);
+typedef epicsEventId(*epicsEventCreate_t)(epicsEventInitialState initialState);
+typedef epicsEventWaitStatus(*epicsEventWaitWithTimeout_t)(epicsEventId id, double timeOut);
 typedef void caExceptionHandler(struct exception_handler_args);
 typedef int(*ca_add_exception_event_t) (caExceptionHandler *pfunc, void *pArg);
 typedef int(*ca_array_get_t) (chtype type, unsigned long count, chid pChan, void *pValue);
+typedef int(*ca_array_get_callback_t) (chtype type, unsigned long count, chid chanId, caEventCallBackFunc *pFunc, void *pArg);
 typedef int(*ca_array_put_t) (chtype type, unsigned long count, chid chanId, const void *pValue);
 typedef int(*ca_array_put_callback_t) (chtype type, unsigned long count, chid chanId, const void *pValue, caEventCallBackFunc *pFunc, void *pArg);
 typedef int(*ca_attach_context_t) (struct ca_client_context * context);
@@ -425,6 +544,9 @@ typedef unsigned long(*ca_element_count_t) (chid chan);
 typedef void * (*ca_puser_t)(chid chan);
 typedef void(*ca_context_destroy_t) (void);
 typedef void(*ca_detach_context_t) ();
+typedef void(*ca_set_puser_t)(chid chan, void *puser);
+typedef void(*epicsEventDestroy_t)(epicsEventId id);
+typedef void(*epicsEventSignal_t)(epicsEventId id);
 typedef void(*epicsMutexDestroy_t)(epicsMutexId id);
 typedef void(*epicsMutexLock_t)(epicsMutexId id);
 typedef void(*epicsMutexUnlock_t)(epicsMutexId id);
@@ -433,6 +555,7 @@ typedef void(*epicsThreadSleep_t)(double seconds);
 ca_add_exception_event_t ca_add_exception_event = 0x0;
 ca_attach_context_t ca_attach_context = 0x0;
 ca_array_get_t ca_array_get = 0x0;
+ca_array_get_callback_t ca_array_get_callback = 0x0;
 ca_array_put_t ca_array_put = 0x0;
 ca_array_put_callback_t ca_array_put_callback = 0x0;
 ca_clear_channel_t ca_clear_channel = 0x0;
@@ -450,10 +573,15 @@ ca_message_t ca_message = 0x0;
 ca_name_t ca_name = 0x0;
 ca_pend_io_t ca_pend_io = 0x0;
 ca_puser_t ca_puser = 0x0;
+ca_set_puser_t ca_set_puser = 0x0;
 ca_state_t ca_state = 0x0;
 dbr_value_offset_t dbr_value_offset = 0x0;
 envGetConfigParamPtr_t envGetConfigParamPtr = 0x0;
 env_param_list_t env_param_list = 0x0;
+epicsEventCreate_t epicsEventCreate = 0x0;
+epicsEventDestroy_t epicsEventDestroy = 0x0;
+epicsEventSignal_t epicsEventSignal = 0x0;
+epicsEventWaitWithTimeout_t epicsEventWaitWithTimeout = 0x0;
 epicsMutexDestroy_t epicsMutexDestroy = 0x0;
 epicsMutexLock_t epicsMutexLock = 0x0;
 epicsMutexTryLock_t epicsMutexTryLock = 0x0;
@@ -476,6 +604,11 @@ dbr_size_t dbr_size = 0x0;
 
 #define MAX_NAME_SIZE (PVNAME_STRINGSZ) /* from EPICS base dbDefs.h */ 
 
+class calabItem;
+struct asyncPut;
+struct batchSubscriber;
+struct deliveryState;
+template<typename T> class boundedQueue;
 MgErr DeleteStringArray(sStringArrayHdl array);
 void DbgTime(void);
 MgErr CaLabDbgPrintf(const char *format, ...);
@@ -483,6 +616,12 @@ MgErr CaLabDbgPrintfD(const char *format, ...);
 void connectionChanged(connection_handler_args args);
 void valueChanged(evargs args);
 void putState(evargs args);
+void putDone(evargs args);
+void postJob(calabItem* item, uInt32 job);
+void queueEvent(calabItem* item);
+void clearBatchEvents();
+void deferEvent(calabItem* item, std::chrono::steady_clock::time_point due);
+void postTeardown(evid eventID, chanId channelID);
 void caLabLoad(void);
 void caLabUnload(void);
 
@@ -496,7 +635,902 @@ std::atomic<int>            allItemsConnected2(0); // indicator for first call a
 std::atomic<int>            tasks(0);			   // number of parallel tasks
 static bool					err200 = false;        // send one error 200 message only
 uInt32						currentlyConnectedPos = 6 * sizeof(void*) + sizeof(unsigned int); // direct access to connect indicator in channell access object
-epicsMutexId				getLock;				// object mutex
+std::deque<calabItem*>      jobQueue;              // data objects with pending jobs for caTask
+epicsMutexId				jobLock = 0x0;          // mutex of job queue
+epicsEventId				jobEvent = 0x0;         // wakes up caTask
+std::atomic<bool>			flushRequested(false); // puts of putValue wait for caTask to flush them
+uInt32						batchSize = BATCH_SIZE; // number of subscriptions per flush
+uInt32						maxReconnectDelay = MAX_RECONNECT_DELAY; // upper limit of reconnect delay in seconds
+std::atomic<uInt32>			progressTotal(0);      // number of data objects
+std::atomic<uInt32>			progressConnected(0);  // number of connected data objects
+std::atomic<uInt32>			progressPending(0);    // number of active data objects without subscription
+std::deque<evid>			teardownEvents;        // subscriptions to be cleared by caTeardownTask
+std::deque<chanId>			teardownChannels;      // channels to be cleared by caTeardownTask
+epicsMutexId				teardownLock = 0x0;     // mutex of teardown queues
+epicsEventId				teardownEvent = 0x0;    // wakes up caTeardownTask
+boundedQueue<asyncPut*>*	putQueue = 0x0;         // asynchronous puts for caPutTask
+epicsEventId				putEvent = 0x0;         // wakes up caPutTask
+uInt32						putQueueSize = PUT_QUEUE_SIZE; // capacity of asynchronous put queue
+std::atomic<uInt32>			putDropped(0);         // asynchronous puts rejected because of full queue
+bool						bCoalescePuts = false; // TRUE: newer asynchronous put replaces queued put of same PV (last writer wins)
+std::atomic<uInt32>			eventEpoch(1);         // changes whenever LV unloads or aborts a VI, event handles have to be validated again
+boundedQueue<calabItem*>*	dispatchQueue = 0x0;    // data objects with pending LV user events for caDispatchTask
+std::vector<batchSubscriber*> batchSubscribers;     // subscribers of batched user events (addBatchEvent)
+epicsMutexId				batchLock = 0x0;        // mutex of batchSubscribers
+epicsEventId				dispatchEvent = 0x0;    // wakes up caDispatchTask
+std::vector<calabItem*>		deferredEvents;         // data objects with LV user events held back by rate limits
+epicsMutexId				deferLock = 0x0;        // mutex of deferredEvents
+std::vector<void*>			freeBuffers[BUFFER_CLASSES]; // released write buffers per size class
+std::vector<asyncPut*>		freePuts;               // released asynchronous puts with their write buffers
+epicsMutexId				bufferLock = 0x0;       // mutex of freeBuffers and freePuts
+std::map<void*, std::shared_ptr<deliveryState>> deliveries; // delivery state of getValue callers by PvIndexArray handle
+uInt32						deliveryEpoch = 0;      // eventEpoch of deliveries
+epicsMutexId				deliveryLock = 0x0;     // mutex of deliveries
+
+// convert single value into another data type
+// integer targets saturate at their limits, fractions are truncated, NaN becomes 0
+//    value: source value
+template<typename T, typename S> inline T castValue(S value) {
+	if (std::numeric_limits<T>::is_integer) {
+		double d = (double)value;
+		if (d != d)
+			return 0;
+		if (d <= (double)std::numeric_limits<T>::min())
+			return std::numeric_limits<T>::min();
+		if (d >= (double)std::numeric_limits<T>::max())
+			return std::numeric_limits<T>::max();
+	}
+	return (T)value;
+}
+
+// conversion of value arrays between EPICS and LV data types
+// generic version converts value by value, specializations below use SIMD instructions (SSE2 / AVX2)
+//    Saturate: true = integer targets saturate (reading), false = plain cast keeps low bits of integers (writing)
+template<typename S, typename T, bool Saturate> struct valueConverter {
+	static void convert(const S* source, T* target, uInt32 count) {
+		for (uInt32 i = 0; i < count; i++)
+			target[i] = Saturate ? castValue<T>(source[i]) : (T)source[i];
+	}
+};
+
+// same data type: plain copy
+template<typename T, bool Saturate> struct valueConverter<T, T, Saturate> {
+	static void convert(const T* source, T* target, uInt32 count) {
+		if (count)
+			memcpy(target, source, count * sizeof(T));
+	}
+};
+
+// DBF_SHORT to double
+template<bool Saturate> struct valueConverter<dbr_short_t, double, Saturate> {
+	static void convert(const dbr_short_t* source, double* target, uInt32 count) {
+		uInt32 i = 0;
+#if defined CALAB_AVX2
+		for (; i + 8 <= count; i += 8) {
+			__m256i v = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)(source + i)));
+			_mm256_storeu_pd(target + i, _mm256_cvtepi32_pd(_mm256_castsi256_si128(v)));
+			_mm256_storeu_pd(target + i + 4, _mm256_cvtepi32_pd(_mm256_extracti128_si256(v, 1)));
+		}
+#elif defined CALAB_SSE2
+		for (; i + 8 <= count; i += 8) {
+			__m128i v = _mm_loadu_si128((const __m128i*)(source + i));
+			__m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+			__m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+			_mm_storeu_pd(target + i, _mm_cvtepi32_pd(lo));
+			_mm_storeu_pd(target + i + 2, _mm_cvtepi32_pd(_mm_shuffle_epi32(lo, 0xEE)));
+			_mm_storeu_pd(target + i + 4, _mm_cvtepi32_pd(hi));
+			_mm_storeu_pd(target + i + 6, _mm_cvtepi32_pd(_mm_shuffle_epi32(hi, 0xEE)));
+		}
+#endif
+		for (; i < count; i++)
+			target[i] = source[i];
+	}
+};
+
+// DBF_ENUM to double
+template<bool Saturate> struct valueConverter<dbr_enum_t, double, Saturate> {
+	static void convert(const dbr_enum_t* source, double* target, uInt32 count) {
+		uInt32 i = 0;
+#if defined CALAB_AVX2
+		for (; i + 8 <= count; i += 8) {
+			__m256i v = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(source + i)));
+			_mm256_storeu_pd(target + i, _mm256_cvtepi32_pd(_mm256_castsi256_si128(v)));
+			_mm256_storeu_pd(target + i + 4, _mm256_cvtepi32_pd(_mm256_extracti128_si256(v, 1)));
+		}
+#elif defined CALAB_SSE2
+		__m128i zero = _mm_setzero_si128();
+		for (; i + 8 <= count; i += 8) {
+			__m128i v = _mm_loadu_si128((const __m128i*)(source + i));
+			__m128i lo = _mm_unpacklo_epi16(v, zero);
+			__m128i hi = _mm_unpackhi_epi16(v, zero);
+			_mm_storeu_pd(target + i, _mm_cvtepi32_pd(lo));
+			_mm_storeu_pd(target + i + 2, _mm_cvtepi32_pd(_mm_shuffle_epi32(lo, 0xEE)));
+			_mm_storeu_pd(target + i + 4, _mm_cvtepi32_pd(hi));
+			_mm_storeu_pd(target + i + 6, _mm_cvtepi32_pd(_mm_shuffle_epi32(hi, 0xEE)));
+		}
+#endif
+		for (; i < count; i++)
+			target[i] = source[i];
+	}
+};
+
+// DBF_CHAR to double
+template<bool Saturate> struct valueConverter<dbr_char_t, double, Saturate> {
+	static void convert(const dbr_char_t* source, double* target, uInt32 count) {
+		uInt32 i = 0;
+#if defined CALAB_AVX2
+		for (; i + 8 <= count; i += 8) {
+			__m256i v = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(source + i)));
+			_mm256_storeu_pd(target + i, _mm256_cvtepi32_pd(_mm256_castsi256_si128(v)));
+			_mm256_storeu_pd(target + i + 4, _mm256_cvtepi32_pd(_mm256_extracti128_si256(v, 1)));
+		}
+#elif defined CALAB_SSE2
+		__m128i zero = _mm_setzero_si128();
+		for (; i + 8 <= count; i += 8) {
+			__m128i v = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(source + i)), zero);
+			__m128i lo = _mm_unpacklo_epi16(v, zero);
+			__m128i hi = _mm_unpackhi_epi16(v, zero);
+			_mm_storeu_pd(target + i, _mm_cvtepi32_pd(lo));
+			_mm_storeu_pd(target + i + 2, _mm_cvtepi32_pd(_mm_shuffle_epi32(lo, 0xEE)));
+			_mm_storeu_pd(target + i + 4, _mm_cvtepi32_pd(hi));
+			_mm_storeu_pd(target + i + 6, _mm_cvtepi32_pd(_mm_shuffle_epi32(hi, 0xEE)));
+		}
+#endif
+		for (; i < count; i++)
+			target[i] = source[i];
+	}
+};
+
+// DBF_LONG to double
+template<bool Saturate> struct valueConverter<dbr_long_t, double, Saturate> {
+	static void convert(const dbr_long_t* source, double* target, uInt32 count) {
+		uInt32 i = 0;
+#if defined CALAB_AVX2
+		for (; i + 4 <= count; i += 4)
+			_mm256_storeu_pd(target + i, _mm256_cvtepi32_pd(_mm_loadu_si128((const __m128i*)(source + i))));
+#elif defined CALAB_SSE2
+		for (; i + 4 <= count; i += 4) {
+			__m128i v = _mm_loadu_si128((const __m128i*)(source + i));
+			_mm_storeu_pd(target + i, _mm_cvtepi32_pd(v));
+			_mm_storeu_pd(target + i + 2, _mm_cvtepi32_pd(_mm_shuffle_epi32(v, 0xEE)));
+		}
+#endif
+		for (; i < count; i++)
+			target[i] = source[i];
+	}
+};
+
+// DBF_FLOAT to double
+template<bool Saturate> struct valueConverter<dbr_float_t, double, Saturate> {
+	static void convert(const dbr_float_t* source, double* target, uInt32 count) {
+		uInt32 i = 0;
+#if defined CALAB_AVX2
+		for (; i + 4 <= count; i += 4)
+			_mm256_storeu_pd(target + i, _mm256_cvtps_pd(_mm_loadu_ps(source + i)));
+#elif defined CALAB_SSE2
+		for (; i + 4 <= count; i += 4) {
+			__m128 v = _mm_loadu_ps(source + i);
+			_mm_storeu_pd(target + i, _mm_cvtps_pd(v));
+			_mm_storeu_pd(target + i + 2, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+		}
+#endif
+		for (; i < count; i++)
+			target[i] = source[i];
+	}
+};
+
+// double to DBR_FLOAT (writing)
+template<bool Saturate> struct valueConverter<double, dbr_float_t, Saturate> {
+	static void convert(const double* source, dbr_float_t* target, uInt32 count) {
+		uInt32 i = 0;
+#if defined CALAB_AVX2
+		for (; i + 4 <= count; i += 4)
+			_mm_storeu_ps(target + i, _mm256_cvtpd_ps(_mm256_loadu_pd(source + i)));
+#elif defined CALAB_SSE2
+		for (; i + 4 <= count; i += 4)
+			_mm_storeu_ps(target + i, _mm_movelh_ps(_mm_cvtpd_ps(_mm_loadu_pd(source + i)), _mm_cvtpd_ps(_mm_loadu_pd(source + i + 2))));
+#endif
+		for (; i < count; i++)
+			target[i] = (dbr_float_t)source[i];
+	}
+};
+
+// I64 to DBR_LONG (writing, keeps low 32 bits)
+template<> struct valueConverter<int64_t, dbr_long_t, false> {
+	static void convert(const int64_t* source, dbr_long_t* target, uInt32 count) {
+		uInt32 i = 0;
+#if defined CALAB_SSE2
+		for (; i + 4 <= count; i += 4) {
+			__m128 a = _mm_castsi128_ps(_mm_loadu_si128((const __m128i*)(source + i)));
+			__m128 b = _mm_castsi128_ps(_mm_loadu_si128((const __m128i*)(source + i + 2)));
+			_mm_storeu_si128((__m128i*)(target + i), _mm_castps_si128(_mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0))));
+		}
+#endif
+		for (; i < count; i++)
+			target[i] = (dbr_long_t)source[i];
+	}
+};
+
+// I64 to DBR_SHORT (writing, keeps low 16 bits)
+template<> struct valueConverter<int64_t, dbr_short_t, false> {
+	static void convert(const int64_t* source, dbr_short_t* target, uInt32 count) {
+		uInt32 i = 0;
+#if defined CALAB_SSE2
+		for (; i + 8 <= count; i += 8) {
+			__m128 a = _mm_castsi128_ps(_mm_loadu_si128((const __m128i*)(source + i)));
+			__m128 b = _mm_castsi128_ps(_mm_loadu_si128((const __m128i*)(source + i + 2)));
+			__m128 c = _mm_castsi128_ps(_mm_loadu_si128((const __m128i*)(source + i + 4)));
+			__m128 d = _mm_castsi128_ps(_mm_loadu_si128((const __m128i*)(source + i + 6)));
+			// low 32 bits, sign extended low 16 bits fit into signed saturation of pack
+			__m128i lo = _mm_castps_si128(_mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+			__m128i hi = _mm_castps_si128(_mm_shuffle_ps(c, d, _MM_SHUFFLE(2, 0, 2, 0)));
+			lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+			hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+			_mm_storeu_si128((__m128i*)(target + i), _mm_packs_epi32(lo, hi));
+		}
+#endif
+		for (; i < count; i++)
+			target[i] = (dbr_short_t)source[i];
+	}
+};
+
+// convert values for reading (integer targets saturate)
+//    source: first source value
+//    target: first target value
+//    count: number of values
+template<typename S, typename T> inline void convertValues(const S* source, T* target, uInt32 count) {
+	valueConverter<S, T, true>::convert(source, target, count);
+}
+
+// convert values for writing (integer targets keep low bits like a C cast)
+//    source: first source value
+//    target: first target value
+//    count: number of values
+template<typename S, typename T> inline void narrowValues(const S* source, T* target, uInt32 count) {
+	valueConverter<S, T, false>::convert(source, target, count);
+}
+
+// check dimensions of optional 2D array
+//    array: pointer to handle of 2D array (0x0 = not used)
+//    rows: number of rows
+//    columns: number of columns
+//    returns true if array is not used or has given dimensions
+template<typename H> bool hasDims(H* array, uInt32 rows, uInt32 columns) {
+	return !array || (*array && (**array)->dimSizes[0] == rows && (**array)->dimSizes[1] == columns);
+}
+
+// validate all handles of LV user event cluster
+//    ResultPtr: cluster of addEvent
+//    returns false if any handle is invalid
+bool validResult(sResult* ResultPtr) {
+	return ResultPtr
+		&& DSCheckPtr(ResultPtr) == noErr
+		&& ResultPtr->PVName
+		&& DSCheckHandle(ResultPtr->PVName) == noErr
+		&& ResultPtr->ValueNumberArray
+		&& DSCheckHandle(ResultPtr->ValueNumberArray) == noErr
+		&& ResultPtr->StringValueArray
+		&& DSCheckHandle(ResultPtr->StringValueArray) == noErr
+		&& ResultPtr->StatusString
+		&& DSCheckHandle(ResultPtr->StatusString) == noErr
+		&& ResultPtr->SeverityString
+		&& DSCheckHandle(ResultPtr->SeverityString) == noErr
+		&& ResultPtr->TimeStampString
+		&& DSCheckHandle(ResultPtr->TimeStampString) == noErr
+		&& ResultPtr->ErrorIO.source
+		&& DSCheckHandle(ResultPtr->ErrorIO.source) == noErr
+		&& (!ResultPtr->FieldNameArray || DSCheckHandle(ResultPtr->FieldNameArray) == noErr)
+		&& (!ResultPtr->FieldValueArray || DSCheckHandle(ResultPtr->FieldValueArray) == noErr);
+}
+
+// check whether 64-bit integers fit into dbr_long_t
+//    values: first value
+//    count: number of values
+inline bool fitsInt32(const int64_t* values, int32 count) {
+	for (int32 i = 0; i < count; i++) {
+		if (values[i] < std::numeric_limits<dbr_long_t>::min() || values[i] > std::numeric_limits<dbr_long_t>::max())
+			return false;
+	}
+	return true;
+}
+
+// raise maximum of statistics value
+//    target: maximum
+//    value: new sample
+inline void storeMax(std::atomic<double>& target, double value) {
+	double current = target.load(std::memory_order_relaxed);
+	while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed));
+}
+
+// get write buffer from pool
+// sizes are rounded up to power of 2 classes, so growing buffers are replaced rarely
+//    size: minimum size in bytes
+//    capacity: resulting size of buffer in bytes
+//    returns 0x0 if out of memory
+void* getBuffer(uInt32 size, uInt32 &capacity) {
+	void* buffer = 0x0;
+	uInt32 sizeClass = 0;
+	capacity = MIN_BUFFER_SIZE;
+	while (capacity < size && sizeClass < BUFFER_CLASSES) {
+		capacity <<= 1;
+		sizeClass++;
+	}
+	if (sizeClass >= BUFFER_CLASSES) {
+		capacity = size;
+		return malloc(size);
+	}
+	if (bufferLock) {
+		epicsMutexLock(bufferLock);
+		if (!freeBuffers[sizeClass].empty()) {
+			buffer = freeBuffers[sizeClass].back();
+			freeBuffers[sizeClass].pop_back();
+		}
+		epicsMutexUnlock(bufferLock);
+	}
+	if (!buffer)
+		buffer = malloc(capacity);
+	if (!buffer)
+		capacity = 0;
+	return buffer;
+}
+
+// return write buffer to pool
+//    buffer: buffer of getBuffer (0x0 is ignored)
+//    capacity: size of buffer in bytes
+void releaseBuffer(void* buffer, uInt32 capacity) {
+	if (!buffer)
+		return;
+	uInt32 sizeClass = 0;
+	uInt32 classSize = MIN_BUFFER_SIZE;
+	while (classSize < capacity && sizeClass < BUFFER_CLASSES) {
+		classSize <<= 1;
+		sizeClass++;
+	}
+	if (bufferLock && sizeClass < BUFFER_CLASSES && classSize == capacity) {
+		epicsMutexLock(bufferLock);
+		if (freeBuffers[sizeClass].size() < MAX_FREE_BUFFERS) {
+			if (!freeBuffers[sizeClass].capacity())
+				freeBuffers[sizeClass].reserve(MAX_FREE_BUFFERS);
+			freeBuffers[sizeClass].push_back(buffer);
+			buffer = 0x0;
+		}
+		epicsMutexUnlock(bufferLock);
+	}
+	free(buffer);
+}
+
+// copy LV string into EPICS string buffer
+// remaining bytes of target are cleared, long strings are truncated
+//    target: buffer of MAX_STRING_SIZE
+//    value: LV string (0x0 = empty)
+//    decimalPoint: true = replace decimal comma by point (numbers of LV in some locales)
+//    returns length of copied string
+inline int32 copyString(char* target, LStrHandle value, bool decimalPoint) {
+	int32 length = 0;
+	if (value && *value) {
+		length = (*value)->cnt < MAX_STRING_SIZE - 1 ? (*value)->cnt : MAX_STRING_SIZE - 1;
+		const uChar* source = (*value)->str;
+		for (int32 i = 0; i < length; i++)
+			target[i] = (decimalPoint && source[i] == ',') ? '.' : (char)source[i];
+	}
+	memset(target + length, 0, MAX_STRING_SIZE - length);
+	return length;
+}
+
+// copy LV string into std::string
+//    value: LV string (0x0 = empty)
+inline std::string toString(LStrHandle value) {
+	if (!value || !*value)
+		return std::string();
+	return std::string((const char*)(*value)->str, (*value)->cnt);
+}
+
+// write string into LV string, handle is resized if length differs
+//    target: LV string
+//    value: string
+//    length: number of bytes of value
+inline MgErr setString(LStrHandle* target, const char* value, int32 length) {
+	if (!*target || (**target)->cnt != length) {
+		MgErr err = NumericArrayResize(uB, 1, (UHandle*)target, length);
+		if (err != noErr)
+			return err;
+		(**target)->cnt = length;
+	}
+	memcpy((**target)->str, value, length);
+	return noErr;
+}
+
+// write strings into LV string array, array is created again if size differs
+//    target: LV string array
+//    values: strings
+inline MgErr setStrings(sStringArrayHdl* target, const std::vector<std::string>& values) {
+	MgErr err = noErr;
+	if (!*target || DSCheckHandle(*target) != noErr || (**target)->dimSize != values.size()) {
+		if (*target && DSCheckHandle(*target) == noErr)
+			err += DeleteStringArray(*target);
+		*target = (sStringArrayHdl)DSNewHClr(sizeof(size_t) + values.size() * sizeof(LStrHandle[1]));
+		if (!*target)
+			return mFullErr;
+		(**target)->dimSize = values.size();
+	}
+	for (size_t j = 0; j < values.size(); j++)
+		err += setString(&(**target)->elt[j], values[j].data(), (int32)values[j].size());
+	return err;
+}
+
+// format integer as decimal string without printf
+//    target: buffer of MAX_STRING_SIZE, remaining bytes are cleared
+//    value: value to format
+//    returns length of string
+inline int32 formatInteger(char* target, int64_t value) {
+	char digits[24];
+	int32 count = 0;
+	int32 length = 0;
+	uint64_t magnitude = value < 0 ? 0 - (uint64_t)value : (uint64_t)value;
+	do {
+		digits[count++] = (char)('0' + magnitude % 10);
+		magnitude /= 10;
+	} while (magnitude);
+	if (value < 0)
+		target[length++] = '-';
+	while (count)
+		target[length++] = digits[--count];
+	memset(target + length, 0, MAX_STRING_SIZE - length);
+	return length;
+}
+
+// format number with 6 decimals (like "%f") without printf
+// values beyond the exact range of 64-bit integers, NaN and infinity fall back to epicsSnprintf
+//    target: buffer of MAX_STRING_SIZE, remaining bytes are cleared
+//    value: value to format
+//    returns length of string
+inline int32 formatFixed(char* target, double value) {
+	int32 length;
+	if (!(value > -9e12 && value < 9e12)) {
+		length = epicsSnprintf(target, MAX_STRING_SIZE, "%f", value);
+		if (length < 0 || length > MAX_STRING_SIZE - 1)
+			length = MAX_STRING_SIZE - 1;
+		memset(target + length, 0, MAX_STRING_SIZE - length);
+		return length;
+	}
+	// round exact product to nearest, ties to even like printf
+	int64_t scaled = std::llrint(value * 1e6);
+	double rest = std::fma(value, 1e6, -(double)scaled);
+	if (rest > .5 || (rest == .5 && (scaled & 1)))
+		scaled++;
+	else if (rest < -.5 || (rest == -.5 && (scaled & 1)))
+		scaled--;
+	uint64_t magnitude = scaled < 0 ? 0 - (uint64_t)scaled : (uint64_t)scaled;
+	length = 0;
+	if (std::signbit(value))
+		target[length++] = '-';
+	length += formatInteger(target + length, (int64_t)(magnitude / 1000000));
+	target[length++] = '.';
+	uint64_t fraction = magnitude % 1000000;
+	for (int32 i = 5; i >= 0; i--) {
+		target[length + i] = (char)('0' + fraction % 10);
+		fraction /= 10;
+	}
+	length += 6;
+	memset(target + length, 0, MAX_STRING_SIZE - length);
+	return length;
+}
+
+// resize optional 2D array if dimensions differ
+//    array: pointer to handle of 2D array (0x0 = not used)
+//    typeCode: LV numeric type of elements
+//    rows: number of rows
+//    columns: number of columns
+template<typename H> MgErr resizeArray2D(H* array, int32 typeCode, uInt32 rows, uInt32 columns) {
+	if (hasDims(array, rows, columns))
+		return noErr;
+	MgErr err = NumericArrayResize(typeCode, 2, (UHandle*)array, rows * columns);
+	if (err == noErr) {
+		(**array)->dimSizes[0] = rows;
+		(**array)->dimSizes[1] = columns;
+	}
+	return err;
+}
+
+// format single value as string
+//    szTmp: target buffer of MAX_STRING_SIZE
+//    value: value to format
+//    type: native data type (DBF_*) of value
+//    enums: enum strings used for DBF_ENUM
+int32 formatValue(char* szTmp, double value, chtype type, const dbr_gr_enum& enums) {
+	switch (type) {
+	case DBF_FLOAT:
+		return epicsSnprintf(szTmp, MAX_STRING_SIZE, "%g", (float)value);
+	case DBF_DOUBLE:
+		return epicsSnprintf(szTmp, MAX_STRING_SIZE, "%g", value);
+	case DBF_ENUM:
+		if (value >= 0 && value < enums.no_str)
+			return epicsSnprintf(szTmp, MAX_STRING_SIZE, "%s", enums.strs[(uInt32)value]);
+		return epicsSnprintf(szTmp, MAX_STRING_SIZE, "%d", (int32)value);
+	default:
+		return epicsSnprintf(szTmp, MAX_STRING_SIZE, "%d", (int32)value);
+	}
+}
+
+// read values of a PV in native data type
+// a published snapshot is never changed, so readers copy from it without locking the PV
+// its string form is made once by the first reader who needs it (see formatStrings)
+class valueSnapshot {
+public:
+	void*					valueArray = 0x0;						// values in native data type (valueType)
+	size_t					valueArraySize = 0;						// size of value buffer in bytes
+	uInt32					valueCount = 0;							// number of values
+	chtype					valueType = -1;							// data type of values (DBF_*), strings are kept as DBF_DOUBLE
+	dbr_gr_enum				enumStrings;							// enum strings of DBF_ENUM values at time of update
+	mutable sStringArrayHdl	strings = 0x0;							// values as LV strings, valid if stringsValid
+	mutable std::atomic<bool> stringsValid;							// indicator for strings matching valueArray
+	epicsMutexId			stringLock;								// serializes readers formatting strings
+
+	valueSnapshot() {
+		enumStrings.no_str = 0;
+		stringsValid = false;
+		stringLock = epicsMutexCreate();
+	}
+
+	~valueSnapshot() {
+		if (valueArray)
+			free(valueArray);
+		if (strings)
+			DeleteStringArray(strings);
+		epicsMutexDestroy(stringLock);
+	}
+
+	// make sure value buffer holds at least given number of bytes
+	//    size: needed bytes
+	//    returns false if out of memory
+	bool reserve(size_t size) {
+		if (valueArray && valueArraySize >= size)
+			return true;
+		void* tmp = realloc(valueArray, size ? size : 1);
+		if (!tmp)
+			return false;
+		valueArray = tmp;
+		valueArraySize = size;
+		return true;
+	}
+
+	// read value as double
+	//    index: position in value buffer
+	double getDouble(uInt32 index) const {
+		if (!valueArray || index >= valueCount)
+			return 0;
+		switch (valueType) {
+		case DBF_SHORT:
+			return ((dbr_short_t*)valueArray)[index];
+		case DBF_FLOAT:
+			return ((dbr_float_t*)valueArray)[index];
+		case DBF_ENUM:
+			return ((dbr_enum_t*)valueArray)[index];
+		case DBF_CHAR:
+			return ((dbr_char_t*)valueArray)[index];
+		case DBF_LONG:
+			return ((dbr_long_t*)valueArray)[index];
+		case DBF_DOUBLE:
+			return ((dbr_double_t*)valueArray)[index];
+		default:
+			return 0;
+		}
+	}
+
+	// copy values converted into target type
+	//    target: first element of target array
+	//    count: number of values to copy, missing values are set to 0
+	template<typename T> void copyValues(T* target, uInt32 count) const {
+		uInt32 available = valueArray ? (count < valueCount ? count : valueCount) : 0;
+		switch (valueType) {
+		case DBF_SHORT:
+			convertValues((dbr_short_t*)valueArray, target, available);
+			break;
+		case DBF_FLOAT:
+			convertValues((dbr_float_t*)valueArray, target, available);
+			break;
+		case DBF_ENUM:
+			convertValues((dbr_enum_t*)valueArray, target, available);
+			break;
+		case DBF_CHAR:
+			convertValues((dbr_char_t*)valueArray, target, available);
+			break;
+		case DBF_LONG:
+			convertValues((dbr_long_t*)valueArray, target, available);
+			break;
+		case DBF_DOUBLE:
+			convertValues((dbr_double_t*)valueArray, target, available);
+			break;
+		default:
+			available = 0;
+			break;
+		}
+		for (uInt32 i = available; i < count; i++)
+			target[i] = 0;
+	}
+
+	// make sure string buffer holds given number of LV strings (writer of snapshot or stringLock)
+	//    count: number of strings
+	MgErr resizeStrings(long count) const {
+		MgErr err = noErr;
+		if (!strings || (long)(*strings)->dimSize < count) {
+			if (strings && (long)(*strings)->dimSize != count) {
+				err += DeleteStringArray(strings);
+			}
+			strings = (sStringArrayHdl)DSNewHClr(sizeof(size_t) + count * sizeof(LStrHandle[1]));
+			(*strings)->dimSize = count;
+		}
+		return err;
+	}
+
+	// format values as LV strings once per snapshot
+	// monitors only store numbers, strings are made on demand for getValue, postEvent and info
+	// runs without the PV lock, so monitor callbacks are not blocked by formatting large waveforms
+	void formatStrings() const {
+		if (stringsValid.load(std::memory_order_acquire) || !valueArray)
+			return;
+		epicsMutexLock(stringLock);
+		if (!stringsValid.load(std::memory_order_relaxed)) {
+			MgErr err = noErr;
+			int32 iSize;
+			char szTmp[MAX_STRING_SIZE];
+			err += resizeStrings(valueCount);
+			for (uInt32 lCount = 0; lCount < valueCount && strings && lCount < (*strings)->dimSize; lCount++) {
+				iSize = formatValue(szTmp, getDouble(lCount), valueType, enumStrings);
+				if (!(*strings)->elt[lCount] || (*(*strings)->elt[lCount])->cnt != iSize) {
+					err += NumericArrayResize(uB, 1, (UHandle*)&(*strings)->elt[lCount], iSize);
+					(*(*strings)->elt[lCount])->cnt = iSize;
+				}
+				memcpy((*(*strings)->elt[lCount])->str, szTmp, iSize);
+			}
+			stringsValid.store(true, std::memory_order_release);
+			if (err)
+				CaLabDbgPrintf("Error: Memory exception in formatStrings");
+		}
+		epicsMutexUnlock(stringLock);
+	}
+};
+typedef std::shared_ptr<const valueSnapshot> valueSnapshotPtr;
+
+// countdown latch of a wait4value call
+// PVs count down as soon as they got a value or are known as missing
+class valueLatch {
+public:
+	std::atomic<int32>		count;									// number of PVs still waited for
+	epicsEventId			event;									// signalled when count reaches 0
+	std::vector<int32>		status;									// EPICS status of each put of a put group (putValue, data object of put must be locked)
+
+	valueLatch() {
+		count = 0;
+		event = epicsEventCreate(epicsEventEmpty);
+	}
+
+	~valueLatch() {
+		epicsEventDestroy(event);
+	}
+
+	// PV was resolved
+	void countDown() {
+		if (--count <= 0)
+			epicsEventSignal(event);
+	}
+
+	// wait until all PVs are resolved
+	//    deadline: end of waiting
+	//    returns false on timeout
+	bool wait(std::chrono::steady_clock::time_point deadline) {
+		while (count > 0) {
+			std::chrono::duration<double> remaining = deadline - std::chrono::steady_clock::now();
+			if (remaining.count() <= 0)
+				return false;
+			epicsEventWaitWithTimeout(event, remaining.count());
+		}
+		return true;
+	}
+};
+typedef std::shared_ptr<valueLatch> valueLatchPtr;
+
+// put with callback waiting for putState
+struct putSlot {
+	valueLatchPtr			latch;									// put group of synchronous putValue call, empty if nobody waits
+	uInt32					row;									// index of put in put group
+	std::chrono::steady_clock::time_point issued;					// time of ca_array_put_callback
+};
+
+// rate limit of LV user event subscriber (token bucket)
+// up to capacity events are posted back to back, further events wait for the next token
+// an update held back is replaced by newer updates (latest only)
+struct eventLimit {
+	double					interval = 0;							// seconds per token (0 = unlimited)
+	double					capacity = 1;							// maximum number of tokens
+	double					tokens = 1;								// number of available tokens
+	std::chrono::steady_clock::time_point refilled;					// time of last refill
+	bool					pending = false;						// update held back
+
+	// take token for one event
+	//    now: current time
+	//    returns 0 if event may be posted, otherwise seconds until next token
+	double take(std::chrono::steady_clock::time_point now) {
+		tokens = std::min(capacity, tokens + std::chrono::duration<double>(now - refilled).count() / interval);
+		refilled = now;
+		if (tokens >= 1) {
+			tokens -= 1;
+			return 0;
+		}
+		return (1 - tokens) * interval;
+	}
+};
+
+// LV user event subscriber of a data object
+struct eventSubscriber {
+	LVUserEventRef			RefNum;									// reference number for LV user event
+	sResult*				cluster;								// reference object for LV user event
+	uInt32					epoch;									// eventEpoch of last validation of cluster
+	uInt32					profile;								// payload of cluster (PAYLOAD_*)
+	eventLimit				limit;									// rate limit of cluster
+};
+
+// status of a data object copied for LV user events, which are posted without its lock
+struct eventStatus {
+	int16_t					StatusNumber;							// number of EPICS status
+	int16_t					SeverityNumber;							// number of EPICS severity
+	uInt32					TimeStampNumber;						// number of time stamp
+	sError					ErrorIO;								// error struct (source is not used)
+	std::string				StatusString;							// EPICS status (strings only for PAYLOAD_STRINGS)
+	std::string				SeverityString;							// EPICS severity
+	std::string				TimeStampString;						// time stamp
+	std::string				ErrorSource;							// source of error struct
+	std::vector<std::string> FieldNames;							// field names
+	std::vector<std::string> FieldValues;							// field values
+};
+
+// bounded lock-free queue for multiple producers and consumers
+// each cell carries a sequence number, so threads only contend for the head and tail positions
+template<typename T> class boundedQueue {
+	struct cell {
+		std::atomic<size_t>	sequence;							// position of cell in ring of current round
+		T					data;								// stored element
+	};
+	cell*					cells;									// ring buffer
+	size_t					mask;									// capacity - 1 (capacity is power of 2)
+	std::atomic<size_t>		enqueuePos;								// next position to write
+	std::atomic<size_t>		dequeuePos;								// next position to read
+
+public:
+	// create queue
+	//    size: minimum capacity, rounded up to power of 2
+	boundedQueue(size_t size) {
+		size_t capacity = 2;
+		while (capacity < size)
+			capacity <<= 1;
+		cells = new cell[capacity];
+		mask = capacity - 1;
+		for (size_t i = 0; i < capacity; i++)
+			cells[i].sequence.store(i, std::memory_order_relaxed);
+		enqueuePos.store(0, std::memory_order_relaxed);
+		dequeuePos.store(0, std::memory_order_relaxed);
+	}
+
+	~boundedQueue() {
+		delete[] cells;
+	}
+
+	// append element
+	//    data: element
+	//    returns false if queue is full
+	bool push(const T &data) {
+		cell* current;
+		size_t pos = enqueuePos.load(std::memory_order_relaxed);
+		for (;;) {
+			current = &cells[pos & mask];
+			size_t sequence = current->sequence.load(std::memory_order_acquire);
+			intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+			if (diff == 0) {
+				if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (diff < 0) {
+				return false;
+			}
+			else {
+				pos = enqueuePos.load(std::memory_order_relaxed);
+			}
+		}
+		current->data = data;
+		current->sequence.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	// remove first element
+	//    data: element
+	//    returns false if queue is empty
+	bool pop(T &data) {
+		cell* current;
+		size_t pos = dequeuePos.load(std::memory_order_relaxed);
+		for (;;) {
+			current = &cells[pos & mask];
+			size_t sequence = current->sequence.load(std::memory_order_acquire);
+			intptr_t diff = (intptr_t)sequence - (intptr_t)(pos + 1);
+			if (diff == 0) {
+				if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (diff < 0) {
+				return false;
+			}
+			else {
+				pos = dequeuePos.load(std::memory_order_relaxed);
+			}
+		}
+		data = current->data;
+		current->sequence.store(pos + mask + 1, std::memory_order_release);
+		return true;
+	}
+
+	// number of queued elements (snapshot)
+	size_t size() {
+		size_t head = dequeuePos.load(std::memory_order_relaxed);
+		size_t tail = enqueuePos.load(std::memory_order_relaxed);
+		return tail > head ? tail - head : 0;
+	}
+
+	// maximum number of queued elements
+	size_t capacity() {
+		return mask + 1;
+	}
+};
+
+// converted put of putValue waiting for caPutTask
+struct asyncPut {
+	calabItem*				item;									// written data object
+	chtype					type;									// EPICS data type of buffer
+	int32					count;									// number of values in buffer
+	void*					buffer = 0x0;							// converted values
+	uInt32					bufferSize = 0;							// size of buffer in bytes
+	LVUserEventRef			RefNum;									// LV user event for completion (sPutResult)
+	bool					notify = false;							// true = post completion to RefNum
+
+	~asyncPut() {
+		releaseBuffer(buffer, bufferSize);
+	}
+};
+
+// get asynchronous put from pool
+// a reused put keeps its write buffer, convertPut replaces it only if it is too small
+asyncPut* getPut() {
+	asyncPut* job = 0x0;
+	if (bufferLock) {
+		epicsMutexLock(bufferLock);
+		if (!freePuts.empty()) {
+			job = freePuts.back();
+			freePuts.pop_back();
+		}
+		epicsMutexUnlock(bufferLock);
+	}
+	if (!job)
+		job = new asyncPut();
+	return job;
+}
+
+// return asynchronous put to pool
+//    job: put of getPut (0x0 is ignored)
+void releasePut(asyncPut* job) {
+	if (!job)
+		return;
+	job->item = 0x0;
+	job->notify = false;
+	if (bufferLock) {
+		epicsMutexLock(bufferLock);
+		if (freePuts.size() < MAX_FREE_PUTS) {
+			if (!freePuts.capacity())
+				freePuts.reserve(MAX_FREE_PUTS);
+			freePuts.push_back(job);
+			job = 0x0;
+		}
+		epicsMutexUnlock(bufferLock);
+	}
+	delete job;
+}
 
 													// internal data object
 class calabItem {
@@ -508,7 +1542,8 @@ public:
 	char					szName[MAX_NAME_SIZE];				// PV name as null-terminated string
 	evid					caEnumEventID = 0x0;					// event ID for subscription of enums
 	evid					caEventID = 0x0;						// event ID for subscription of values
-	sDoubleArrayHdl			doubleValueArray = 0x0;					// buffer for read values (Doubles)
+	valueSnapshotPtr		values;									// latest read values (access with std::atomic_load / std::atomic_store)
+	std::shared_ptr<valueSnapshot> nextValues;						// buffer for next monitor update (object must be locked)
 	sError					ErrorIO;								// error struct buffer
 	sStringArrayHdl			FieldNameArray = 0x0;					// field names buffer
 	sStringArrayHdl			FieldValueArray = 0x0;					// field values buffer
@@ -516,28 +1551,60 @@ public:
 	std::atomic<bool>		isConnected;							// indicator for successfully connect to server
 	std::atomic<bool>		isPassive;								// indicator for polling values instead of monitoring
 	uInt32					iFieldID = 0;							// field indicator for field objects
-	std::atomic<bool>		putReadBack;							// indicator for synchronized reading
+	std::vector<putSlot>	putSlots;								// puts waiting for put callbacks in order of puts from putSlotsHead on (object must be locked)
+	size_t					putSlotsHead = 0;						// oldest put in putSlots, storage is reused (object must be locked)
+	asyncPut*				pendingPut = 0x0;						// queued asynchronous put not yet taken by caPutTask (object must be locked)
+	std::atomic<uInt32>		putsSent;								// puts issued to Channel Access
+	std::atomic<uInt32>		putsCoalesced;							// queued puts replaced by newer values
+	std::atomic<bool>		eventQueued;							// data object waits in dispatch queue (coalesces user events)
 	std::atomic<bool>		fieldModified;							// indicator for changed field value
 	epicsMutexId			myLock;									// object mutex
+	epicsMutexId			postLock;								// serializes writers of eventSubscribers' clusters (postEvent)
 	LStrHandle				name = 0x0;								// PV name as LV string
 	calabItem*				next = 0x0;								// pointer to following item
 	calabItem*				parent = 0x0;							// parent of field object = main object with values
+	std::vector<calabItem*>	fieldItems;								// field objects of this main object
 	calabItem*				previous = 0x0;							// pointer to previous item
 	int16_t					SeverityNumber = epicsSevInvalid;		// number of EPICS severity
 	LStrHandle				SeverityString = 0x0;					// LV string of EPICS severity
 	int16_t					StatusNumber = epicsAlarmComm;			// number of EPICS status
 	LStrHandle				StatusString = 0x0;						// LV string of EPICS status
-	sStringArrayHdl			stringValueArray = 0x0;					// buffer for read values (LV strings)
 	uInt32					TimeStampNumber = 0;					// number of time stamp
 	LStrHandle				TimeStampString = 0x0;					// LV string of time stamp
 	dbr_gr_enum   			sEnum;									// enumeration String
-	std::vector<LVUserEventRef> RefNum;							// reference number for LV user event
-	std::vector<sResult*>			eventResultCluster;				// reference object for LV user event
+	std::vector<eventSubscriber> eventSubscribers;					// LV user events of this PV
+	std::chrono::steady_clock::time_point eventDue;					// time of next held back LV user event (deferLock)
+	bool					eventDeferred = false;					// data object is in deferredEvents (deferLock)
+	std::atomic<uInt32>		eventsPosted;							// LV user events posted
+	std::atomic<uInt32>		eventsCoalesced;						// updates merged into a later LV user event
+	std::atomic<uInt32>		eventsDropped;							// LV user events which could not be posted
+	std::atomic<uInt32>		updates;								// value updates received
+	std::atomic<uint64_t>	bytesReceived;							// bytes of value updates received
+	std::atomic<double>		callbackLast;							// duration of last value callback in seconds
+	std::atomic<double>		callbackMax;							// longest value callback in seconds
+	std::atomic<double>		intervalMean;							// mean seconds between value updates
+	std::atomic<double>		intervalJitter;							// standard deviation of seconds between value updates
+	std::atomic<uInt32>		connects;								// number of connects
+	std::atomic<uInt32>		disconnects;							// number of disconnects
+	std::atomic<double>		firstValueDelay;						// seconds from creating channel to first value (-1 = no value yet)
+	std::atomic<double>		putLatencyLast;							// seconds from last put with callback to its completion
+	std::atomic<double>		putLatencyMax;							// longest put with callback in seconds
+	std::chrono::steady_clock::time_point channelCreated;			// time of ca_create_channel (object must be locked)
+	std::chrono::steady_clock::time_point lastUpdate;				// time of previous value update (object must be locked)
+	double					intervalM2 = 0;							// sum of squared deviations from intervalMean (object must be locked)
+	uInt32					intervals = 0;							// number of measured intervals (object must be locked)
 	void*					writeValueArray = 0x0;					// buffer for output
 	uInt32					writeValueArraySize = 0;				// size of output buffer
 	std::atomic<bool>       locked;									// indicator of locked object
 	std::chrono::high_resolution_clock::time_point timer;			// watch dog timer
 	bool					initConnect;
+	std::atomic<uInt32>		jobs;									// pending jobs for caTask (JOB_*)
+	bool					watchdog = false;						// indicator for armed watch dog timer (caTask only)
+	std::atomic<uInt32>		retryCount;								// attempts to recreate channel since last connect
+	std::atomic<bool>		isMissing;								// negative cache: channel did not connect within reconnect delay
+	std::atomic<uInt32>		updateSequence;							// counts changes of values, alarm, time stamp, error and field values
+	std::vector<valueLatchPtr> latches;								// wait4value calls waiting for this PV (object must be locked)
+	std::atomic<bool>		pollPending;							// value was requested once (JOB_GET), read as soon as connected
 
 	calabItem(LStrHandle name, sStringArrayHdl fieldNames = 0x0) {
 		initConnect = false;
@@ -547,7 +1614,30 @@ public:
 		fieldModified = false;
 		validAddress = this;
 		locked = false;
+		jobs = 0;
+		retryCount = 0;
+		isMissing = false;
+		updateSequence = 1;
+		pollPending = false;
+		putsSent = 0;
+		putsCoalesced = 0;
+		eventQueued = false;
+		eventsPosted = 0;
+		eventsCoalesced = 0;
+		eventsDropped = 0;
+		updates = 0;
+		bytesReceived = 0;
+		callbackLast = 0;
+		callbackMax = 0;
+		intervalMean = 0;
+		intervalJitter = 0;
+		connects = 0;
+		disconnects = 0;
+		firstValueDelay = -1;
+		putLatencyLast = 0;
+		putLatencyMax = 0;
 		myLock = epicsMutexCreate();
+		postLock = epicsMutexCreate();
 		if ((*name)->cnt < MAX_NAME_SIZE - 1) {
 			NumericArrayResize(uB, 1, (UHandle*)&this->name, (*name)->cnt);
 			memcpy((*this->name)->str, (*name)->str, (*name)->cnt);
@@ -631,25 +1721,10 @@ public:
 		ca_clear_channel(caID);
 		ca_pend_io(3);
 		}*/
-		if (RefNum.size() || eventResultCluster.size()) {
-			std::vector<LVUserEventRef>::iterator itRefNum = RefNum.begin();
-			while (itRefNum != RefNum.end()) {
-				itRefNum = RefNum.erase(itRefNum);
-			}
-			std::vector<sResult*>::iterator itEventResultCluster = eventResultCluster.begin();
-			while (itEventResultCluster != eventResultCluster.end()) {
-				itEventResultCluster = eventResultCluster.erase(itEventResultCluster);
-			}
-		}
+		eventSubscribers.clear();
 		err += DSDisposeHandle(name);
-		if (doubleValueArray)
-			err += DSDisposeHandle(doubleValueArray);
-		if (stringValueArray) {
-			for (uInt32 i = 0; i < (*stringValueArray)->dimSize; i++)
-				err += DSDisposeHandle((*stringValueArray)->elt[i]);
-			(*stringValueArray)->dimSize = 0;
-			err += DSDisposeHandle(stringValueArray);
-		}
+		std::atomic_store(&values, valueSnapshotPtr());
+		nextValues.reset();
 		if (StatusString)
 			err += DSDisposeHandle(StatusString);
 		if (SeverityString)
@@ -661,8 +1736,8 @@ public:
 		if (err)
 			CaLabDbgPrintf("Error: Memory exception in cItem::~Item");
 		epicsMutexDestroy(myLock);
-		if (writeValueArray)
-			free(writeValueArray);
+		epicsMutexDestroy(postLock);
+		releaseBuffer(writeValueArray, writeValueArraySize);
 	}
 
 	// lock this instance
@@ -710,20 +1785,44 @@ public:
 		return err;
 	}
 
+	// mark data of this PV (and field values of its parent) as changed for getValue (object must be locked)
+	void changed() {
+		updateSequence++;
+		if (parent)
+			parent->updateSequence++;
+	}
+
+	// wake up wait4value calls waiting for this PV (object must be locked)
+	void resolved() {
+		for (size_t i = 0; i < latches.size(); i++)
+			latches[i]->countDown();
+		latches.clear();
+	}
+
+	// request monitoring of values
+	void activate() {
+		isPassive = false;
+		postJob(this, JOB_SUBSCRIBE);
+	}
+
+	// read value once without monitoring
+	void poll() {
+		isPassive = true;
+		pollPending = true;
+		postJob(this, JOB_UNSUBSCRIBE | JOB_GET);
+	}
+
+	// stop monitoring of values
+	void deactivate() {
+		isPassive = true;
+		postJob(this, JOB_UNSUBSCRIBE);
+	}
+
 	// disconnect instance from server
 	void disconnect() {
 		lock();
-		isPassive = true;
-		if (RefNum.size() || eventResultCluster.size()) {
-			std::vector<LVUserEventRef>::iterator itRefNum = RefNum.begin();
-			while (itRefNum != RefNum.end()) {
-				itRefNum = RefNum.erase(itRefNum);
-			}
-			std::vector<sResult*>::iterator itEventResultCluster = eventResultCluster.begin();
-			while (itEventResultCluster != eventResultCluster.end()) {
-				itEventResultCluster = eventResultCluster.erase(itEventResultCluster);
-			}
-		}
+		deactivate();
+		eventSubscribers.clear();
 		unlock();
 	}
 
@@ -738,11 +1837,15 @@ public:
 			int32 size;
 			if (args.op == CA_OP_CONN_UP) {
 				lock();
+				connects.fetch_add(1, std::memory_order_relaxed);
 				isConnected = true;
+				isMissing = false;
+				retryCount = 0;
+				postJob(this, pollPending ? JOB_GET : JOB_SUBSCRIBE);
 				//CaLabDbgPrintfD("%s connected", szName);
-				if (RefNum.size()) {
+				if (eventSubscribers.size()) {
 					unlock();
-					postEvent();
+					queueEvent(this);
 				}
 				else {
 					unlock();
@@ -750,7 +1853,13 @@ public:
 			}
 			else if (args.op == CA_OP_CONN_DOWN) {
 				lock();
+				disconnects.fetch_add(1, std::memory_order_relaxed);
+				// outage is no update interval
+				lastUpdate = std::chrono::steady_clock::time_point();
 				isConnected = false;
+				// reconnect delay starts at disconnect, not at creation of channel
+				timer = std::chrono::high_resolution_clock::now();
+				postJob(this, JOB_WATCH);
 				size = (int32)strlen(alarmStatusString[epicsAlarmComm]);
 				if (!StatusString || (*StatusString)->cnt != size) {
 					NumericArrayResize(uB, 1, (UHandle*)&StatusString, size);
@@ -766,10 +1875,11 @@ public:
 				memcpy((*SeverityString)->str, alarmSeverityString[epicsSevInvalid], size);
 				SeverityNumber = epicsSevInvalid;
 				setError(ECA_DISCONN);
+				changed();
 				//CaLabDbgPrintfD("%s disconnected", szName);
-				if (RefNum.size()) {
+				if (eventSubscribers.size()) {
 					unlock();
-					postEvent();
+					queueEvent(this);
 				}
 				else {
 					unlock();
@@ -781,6 +1891,28 @@ public:
 		}
 	}
 
+	// update receive statistics with a value update (object must be locked)
+	//    args: value update of EPICS
+	void recordUpdate(const evargs& args) {
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		updates.fetch_add(1, std::memory_order_relaxed);
+		bytesReceived.fetch_add(dbr_size_n(args.type, args.count), std::memory_order_relaxed);
+		if (firstValueDelay.load(std::memory_order_relaxed) < 0 && channelCreated != std::chrono::steady_clock::time_point())
+			firstValueDelay.store(std::chrono::duration<double>(now - channelCreated).count(), std::memory_order_relaxed);
+		if (lastUpdate != std::chrono::steady_clock::time_point()) {
+			// running mean and variance (Welford)
+			double interval = std::chrono::duration<double>(now - lastUpdate).count();
+			double mean = intervalMean.load(std::memory_order_relaxed);
+			double delta = interval - mean;
+			intervals++;
+			mean += delta / intervals;
+			intervalM2 += delta * (interval - mean);
+			intervalMean.store(mean, std::memory_order_relaxed);
+			intervalJitter.store(std::sqrt(intervalM2 / intervals), std::memory_order_relaxed);
+		}
+		lastUpdate = now;
+	}
+
 	// callback for changed value (incl. field values)
 	void itemValueChanged(evargs args) {
 		try {
@@ -792,21 +1924,19 @@ public:
 			if (!szName[0] || args.status != ECA_NORMAL)
 				return;
 			lock();
+			recordUpdate(args);
 			//CaLabDbgPrintfD("itemValueChanged of %s", szName);
 			numberOfValues = args.count;
-			if (!doubleValueArray || (long)(*doubleValueArray)->dimSize < args.count) {
-				err += NumericArrayResize(fD, 1, (UHandle*)&doubleValueArray, args.count);
-				(*doubleValueArray)->dimSize = args.count;
-			}
-			if (!stringValueArray || (long)(*stringValueArray)->dimSize < args.count) {
-				if (stringValueArray && (long)(*stringValueArray)->dimSize != args.count) {
-					err += DeleteStringArray(stringValueArray);
-				}
-				stringValueArray = (sStringArrayHdl)DSNewHClr(sizeof(size_t) + args.count * sizeof(LStrHandle[1]));
-				(*stringValueArray)->dimSize = args.count;
-			}
+			bool isField = parent && parent->FieldValueArray && iFieldID < (*parent->FieldValueArray)->dimSize;
 			switch (args.type) {
 			case DBR_TIME_STRING:
+				if (!isField) {
+					if (!beginValues(DBF_DOUBLE, sizeof(dbr_double_t), args.count)) {
+						unlock();
+						return;
+					}
+					err += nextValues->resizeStrings(args.count);
+				}
 				for (long lCount = 0; lCount < args.count; lCount++) {
 					char* tmp;
 					iSize = (int32)strlen(((dbr_string_t*)dbr_value_ptr(args.dbr, args.type))[lCount]);
@@ -819,151 +1949,43 @@ public:
 						parent->fieldModified = true;
 					}
 					else {
-						(*doubleValueArray)->elt[lCount] = strtod(((dbr_string_t*)dbr_value_ptr(args.dbr, args.type))[lCount], &tmp);
-						if (!(*stringValueArray)->elt[lCount] || (*(*stringValueArray)->elt[lCount])->cnt != iSize) {
-							err += NumericArrayResize(uB, 1, (UHandle*)&(*stringValueArray)->elt[lCount], iSize);
-							(*(*stringValueArray)->elt[lCount])->cnt = iSize;
+						((dbr_double_t*)nextValues->valueArray)[lCount] = strtod(((dbr_string_t*)dbr_value_ptr(args.dbr, args.type))[lCount], &tmp);
+						if (!(*nextValues->strings)->elt[lCount] || (*(*nextValues->strings)->elt[lCount])->cnt != iSize) {
+							err += NumericArrayResize(uB, 1, (UHandle*)&(*nextValues->strings)->elt[lCount], iSize);
+							(*(*nextValues->strings)->elt[lCount])->cnt = iSize;
 						}
-						memcpy((*(*stringValueArray)->elt[lCount])->str, ((dbr_string_t*)dbr_value_ptr(args.dbr, args.type))[lCount], iSize);
+						memcpy((*(*nextValues->strings)->elt[lCount])->str, ((dbr_string_t*)dbr_value_ptr(args.dbr, args.type))[lCount], iSize);
 					}
 				}
+				if (!isField) {
+					// strings of string PVs are kept as received
+					nextValues->stringsValid = true;
+					publishValues();
+				}
 				bDbrTime = 1;
 				break;
 			case DBR_TIME_SHORT:
-				short shortValue;
-				for (long lCount = 0; lCount < args.count; lCount++) {
-					shortValue = ((dbr_short_t*)dbr_value_ptr(args.dbr, args.type))[lCount];
-					iSize = epicsSnprintf(szTmp, MAX_STRING_SIZE, "%d", (uInt32)shortValue);
-					if (parent && parent->FieldValueArray && iFieldID < (*parent->FieldValueArray)->dimSize) {
-						if ((*(*parent->FieldValueArray)->elt[iFieldID])->cnt != iSize) {
-							err += NumericArrayResize(uB, 1, (UHandle*)&(*parent->FieldValueArray)->elt[iFieldID], iSize);
-							(*(*parent->FieldValueArray)->elt[iFieldID])->cnt = iSize;
-						}
-						memcpy((*(*parent->FieldValueArray)->elt[iFieldID])->str, szTmp, iSize);
-						parent->fieldModified = true;
-					}
-					else {
-						(*doubleValueArray)->elt[lCount] = shortValue;
-						if (!(*stringValueArray)->elt[lCount] || (*(*stringValueArray)->elt[lCount])->cnt != iSize) {
-							err += NumericArrayResize(uB, 1, (UHandle*)&(*stringValueArray)->elt[lCount], iSize);
-							(*(*stringValueArray)->elt[lCount])->cnt = iSize;
-						}
-						memcpy((*(*stringValueArray)->elt[lCount])->str, szTmp, iSize);
-					}
-				}
+				err += valueUpdate<dbr_short_t, DBF_SHORT>(args, isField);
 				bDbrTime = 1;
 				break;
 			case DBR_TIME_CHAR:
-				for (long lCount = 0; lCount < args.count; lCount++) {
-					iSize = epicsSnprintf(szTmp, MAX_STRING_SIZE, "%d", ((dbr_char_t*)dbr_value_ptr(args.dbr, args.type))[lCount]);
-					if (parent && parent->FieldValueArray && iFieldID < (*parent->FieldValueArray)->dimSize) {
-						if ((*(*parent->FieldValueArray)->elt[iFieldID])->cnt != iSize) {
-							err += NumericArrayResize(uB, 1, (UHandle*)&(*parent->FieldValueArray)->elt[iFieldID], iSize);
-							(*(*parent->FieldValueArray)->elt[iFieldID])->cnt = iSize;
-						}
-						memcpy((*(*parent->FieldValueArray)->elt[iFieldID])->str, szTmp, iSize);
-						parent->fieldModified = true;
-					}
-					else {
-						(*doubleValueArray)->elt[lCount] = ((dbr_char_t*)dbr_value_ptr(args.dbr, args.type))[lCount];
-						if (!(*stringValueArray)->elt[lCount] || (*(*stringValueArray)->elt[lCount])->cnt != iSize) {
-							err += NumericArrayResize(uB, 1, (UHandle*)&(*stringValueArray)->elt[lCount], iSize);
-							(*(*stringValueArray)->elt[lCount])->cnt = iSize;
-						}
-						memcpy((*(*stringValueArray)->elt[lCount])->str, szTmp, iSize);
-					}
-				}
+				err += valueUpdate<dbr_char_t, DBF_CHAR>(args, isField);
 				bDbrTime = 1;
 				break;
 			case DBR_TIME_LONG:
-				for (long lCount = 0; lCount < args.count; lCount++) {
-					iSize = epicsSnprintf(szTmp, MAX_STRING_SIZE, "%d", ((dbr_long_t*)dbr_value_ptr(args.dbr, args.type))[lCount]);
-					if (parent && parent->FieldValueArray && iFieldID < (*parent->FieldValueArray)->dimSize) {
-						if ((*(*parent->FieldValueArray)->elt[iFieldID])->cnt != iSize) {
-							err += NumericArrayResize(uB, 1, (UHandle*)&(*parent->FieldValueArray)->elt[iFieldID], iSize);
-							(*(*parent->FieldValueArray)->elt[iFieldID])->cnt = iSize;
-						}
-						memcpy((*(*parent->FieldValueArray)->elt[iFieldID])->str, szTmp, iSize);
-						parent->fieldModified = true;
-					}
-					else {
-						(*doubleValueArray)->elt[lCount] = ((dbr_long_t*)dbr_value_ptr(args.dbr, args.type))[lCount];
-						if (!(*stringValueArray)->elt[lCount] || (*(*stringValueArray)->elt[lCount])->cnt != iSize) {
-							err += NumericArrayResize(uB, 1, (UHandle*)&(*stringValueArray)->elt[lCount], iSize);
-							(*(*stringValueArray)->elt[lCount])->cnt = iSize;
-						}
-						memcpy((*(*stringValueArray)->elt[lCount])->str, szTmp, iSize);
-					}
-				}
+				err += valueUpdate<dbr_long_t, DBF_LONG>(args, isField);
 				bDbrTime = 1;
 				break;
 			case DBR_TIME_FLOAT:
-				for (long lCount = 0; lCount < args.count; lCount++) {
-					iSize = epicsSnprintf(szTmp, MAX_STRING_SIZE, "%g", ((dbr_float_t*)dbr_value_ptr(args.dbr, args.type))[lCount]);
-					if (parent && parent->FieldValueArray && iFieldID < (*parent->FieldValueArray)->dimSize) {
-						if ((*(*parent->FieldValueArray)->elt[iFieldID])->cnt != iSize) {
-							err += NumericArrayResize(uB, 1, (UHandle*)&(*parent->FieldValueArray)->elt[iFieldID], iSize);
-							(*(*parent->FieldValueArray)->elt[iFieldID])->cnt = iSize;
-						}
-						memcpy((*(*parent->FieldValueArray)->elt[iFieldID])->str, szTmp, iSize);
-						parent->fieldModified = true;
-					}
-					else {
-						(*doubleValueArray)->elt[lCount] = ((dbr_float_t*)dbr_value_ptr(args.dbr, args.type))[lCount];
-						if (!(*stringValueArray)->elt[lCount] || (*(*stringValueArray)->elt[lCount])->cnt != iSize) {
-							err += NumericArrayResize(uB, 1, (UHandle*)&(*stringValueArray)->elt[lCount], iSize);
-							(*(*stringValueArray)->elt[lCount])->cnt = iSize;
-						}
-						memcpy((*(*stringValueArray)->elt[lCount])->str, szTmp, iSize);
-					}
-				}
+				err += valueUpdate<dbr_float_t, DBF_FLOAT>(args, isField);
 				bDbrTime = 1;
 				break;
 			case DBR_TIME_DOUBLE:
-				for (long lCount = 0; lCount < args.count; lCount++) {
-					iSize = epicsSnprintf(szTmp, MAX_STRING_SIZE, "%g", ((dbr_double_t*)dbr_value_ptr(args.dbr, args.type))[lCount]);
-					if (parent && parent->FieldValueArray && iFieldID < (*parent->FieldValueArray)->dimSize) {
-						if ((*(*parent->FieldValueArray)->elt[iFieldID])->cnt != iSize) {
-							err += NumericArrayResize(uB, 1, (UHandle*)&(*parent->FieldValueArray)->elt[iFieldID], iSize);
-							(*(*parent->FieldValueArray)->elt[iFieldID])->cnt = iSize;
-						}
-						memcpy((*(*parent->FieldValueArray)->elt[iFieldID])->str, szTmp, iSize);
-						parent->fieldModified = true;
-					}
-					else {
-						(*doubleValueArray)->elt[lCount] = ((dbr_double_t*)dbr_value_ptr(args.dbr, args.type))[lCount];
-						if (!(*stringValueArray)->elt[lCount] || (*(*stringValueArray)->elt[lCount])->cnt != iSize) {
-							err += NumericArrayResize(uB, 1, (UHandle*)&(*stringValueArray)->elt[lCount], iSize);
-							(*(*stringValueArray)->elt[lCount])->cnt = iSize;
-						}
-						memcpy((*(*stringValueArray)->elt[lCount])->str, szTmp, iSize);
-					}
-				}
+				err += valueUpdate<dbr_double_t, DBF_DOUBLE>(args, isField);
 				bDbrTime = 1;
 				break;
 			case DBR_TIME_ENUM:
-				for (long lCount = 0; lCount < args.count; lCount++) {
-					if ((*doubleValueArray)->elt[lCount] < sEnum.no_str)
-						iSize = epicsSnprintf(szTmp, MAX_STRING_SIZE, "%s", sEnum.strs[((dbr_enum_t*)dbr_value_ptr(args.dbr, args.type))[lCount]]);
-					else
-						iSize = epicsSnprintf(szTmp, MAX_STRING_SIZE, "%d", ((dbr_enum_t*)dbr_value_ptr(args.dbr, args.type))[lCount]);
-					if (parent && parent->FieldValueArray && iFieldID < (*parent->FieldValueArray)->dimSize) {
-						if ((*(*parent->FieldValueArray)->elt[iFieldID])->cnt != iSize) {
-							err += NumericArrayResize(uB, 1, (UHandle*)&(*parent->FieldValueArray)->elt[iFieldID], iSize);
-							(*(*parent->FieldValueArray)->elt[iFieldID])->cnt = iSize;
-						}
-						memcpy((*(*parent->FieldValueArray)->elt[iFieldID])->str, szTmp, iSize);
-						parent->fieldModified = true;
-					}
-					else {
-						(*doubleValueArray)->elt[lCount] = ((dbr_enum_t*)dbr_value_ptr(args.dbr, args.type))[lCount];
-						if (!(*stringValueArray)->elt[lCount] || (*(*stringValueArray)->elt[lCount])->cnt != iSize) {
-							err += NumericArrayResize(uB, 1, (UHandle*)&(*stringValueArray)->elt[lCount], iSize);
-							(*(*stringValueArray)->elt[lCount])->cnt = iSize;
-						}
-						memcpy((*(*stringValueArray)->elt[lCount])->str, szTmp, iSize);
-					}
-				}
+				err += valueUpdate<dbr_enum_t, DBF_ENUM>(args, isField);
 				bDbrTime = 1;
 				break;
 			case DBR_CTRL_ENUM:
@@ -974,7 +1996,7 @@ public:
 					epicsSnprintf(sEnum.strs[i], MAX_ENUM_STRING_SIZE, "%s", tmpEnum->strs[i]);
 				}
 				for (long lCount = 0; lCount < args.count; lCount++) {
-					epicsInt16 enumValue = (epicsInt16)(*doubleValueArray)->elt[lCount];
+					epicsInt16 enumValue = (epicsInt16)getDouble(lCount);
 					if (parent && iFieldID < (*parent->FieldValueArray)->dimSize) {
 						iSize = epicsSnprintf(szTmp, MAX_STRING_SIZE, "%s", sEnum.strs[enumValue]);
 						if ((*(*parent->FieldValueArray)->elt[iFieldID])->cnt != iSize) {
@@ -984,26 +2006,21 @@ public:
 						memcpy((*(*parent->FieldValueArray)->elt[iFieldID])->str, szTmp, iSize);
 						parent->fieldModified = true;
 					}
-					if (enumValue < sEnum.no_str) {
-						iSize = epicsSnprintf(szTmp, MAX_STRING_SIZE, "%s", sEnum.strs[enumValue]);
-						(*doubleValueArray)->elt[lCount] = enumValue;
-						if (!(*stringValueArray)->elt[lCount] || (*(*stringValueArray)->elt[lCount])->cnt != iSize) {
-							err += NumericArrayResize(uB, 1, (UHandle*)&(*stringValueArray)->elt[lCount], iSize);
-							(*(*stringValueArray)->elt[lCount])->cnt = iSize;
-						}
-						memcpy((*(*stringValueArray)->elt[lCount])->str, szTmp, iSize);
-					}
-					else {
+					if (enumValue >= sEnum.no_str) {
 						hasValue = true;
 						unlock();
 						return;
 					}
 				}
+				// published values are formatted with enum strings of their snapshot
+				republishEnums();
 				bDbrTime = 0;
 				break;
 			default:
 				setError(ECA_BADTYPE);
+				changed();
 				hasValue = true;
+				resolved();
 				unlock();
 				return;
 			}
@@ -1036,10 +2053,14 @@ public:
 				}
 			}
 			setError(args.status);
+			changed();
 			hasValue = true;
-			if (bDbrTime && RefNum.size()) {
+			// enum strings alone do not complete a read
+			if (bDbrTime)
+				resolved();
+			if (bDbrTime && eventSubscribers.size()) {
 				unlock();
-				postEvent();
+				queueEvent(this);
 			}
 			else {
 				unlock();
@@ -1052,6 +2073,159 @@ public:
 		}
 	}
 
+	// write status of put into LV error cluster
+	//    Error:              resulting error
+	//    iResult:            EPICS status
+	void putError(sError* Error, int32 iResult) {
+		int32 stringSize = (int32)strlen(ca_message(iResult));
+		if (!Error->source || (*Error->source)->cnt != stringSize) {
+			NumericArrayResize(uB, 1, (UHandle*)&Error->source, stringSize);
+			(*Error->source)->cnt = stringSize;
+		}
+		memcpy((*Error->source)->str, ca_message(iResult), stringSize);
+		if (iResult != ECA_NORMAL)
+			Error->code = ERROR_OFFSET + iResult;
+		else
+			Error->code = 0;
+		Error->status = 0;
+	}
+
+	// convert row of LV data array into EPICS transfer buffer
+	//    ValueArray2D:       data array (buffer)
+	//    DataType:           data type (see put)
+	//    Row:                row in data array
+	//    ValuesPerSet:       numbers of values in row
+	//    buffer:             transfer buffer of getBuffer, replaced by a larger one if size does not fit
+	//    bufferSize:         capacity of transfer buffer in bytes
+	//    count:              resulting number of values in transfer buffer
+	//    returns EPICS data type of transfer buffer (TYPENOTCONN for unknown DataType)
+	chtype convertPut(void* ValueArray2D, uInt32 DataType, uInt32 Row, uInt32 ValuesPerSet, void* &buffer, uInt32 &bufferSize, int32 &count) {
+		LStrHandle currentStringValue;
+		char* target;
+		uInt32 iPos = 0;
+		uInt32 size = 0;
+		chtype putType = TYPENOTCONN;
+		if (ValuesPerSet > numberOfValues)
+			count = numberOfValues;
+		else
+			count = ValuesPerSet;
+		// Create new transfer object (buffer) in EPICS data type of request
+		switch (DataType) {
+		case 0:
+			putType = DBR_STRING;
+			break;
+		case 1:
+			putType = nativeType == DBF_STRING ? DBR_STRING : DBR_FLOAT;
+			break;
+		case 2:
+			putType = nativeType == DBF_STRING ? DBR_STRING : DBR_DOUBLE;
+			break;
+		case 3:
+			putType = DBR_CHAR;
+			break;
+		case 4:
+			putType = DBR_SHORT;
+			break;
+		case 5:
+			putType = DBR_LONG;
+			break;
+		case 6:
+			// Channel Access has no 64-bit integers, doubles keep 53 bits instead of truncating to 32 bits
+			if (nativeType == DBF_DOUBLE || !fitsInt32(&(**(sLongArray2DHdl*)ValueArray2D)->elt[Row * ValuesPerSet], count))
+				putType = DBR_DOUBLE;
+			else
+				putType = DBR_LONG;
+			break;
+		default:
+			break;
+		}
+		if (putType != TYPENOTCONN) {
+			// buffers only grow, so steady puts do not allocate
+			size = count * dbr_value_size[putType];
+			if (bufferSize < size || !buffer) {
+				releaseBuffer(buffer, bufferSize);
+				buffer = getBuffer(size, bufferSize);
+				if (!buffer) {
+					bufferSize = 0;
+					return TYPENOTCONN;
+				}
+			}
+		}
+		iPos = Row * ValuesPerSet;
+		// every string slot is written completely (see copyString, formatInteger, formatFixed)
+		switch (DataType) {
+		case 0:
+			for (int32 col = 0; col < count; col++) {
+				currentStringValue = (**(sStringArray2DHdl*)ValueArray2D)->elt[iPos + col];
+				target = (char*)buffer + col * MAX_STRING_SIZE;
+				switch (nativeType) {
+				case DBF_STRING:
+				case DBF_ENUM:
+					copyString(target, currentStringValue, false);
+					break;
+				case DBF_FLOAT:
+					copyString(target, currentStringValue, true);
+					formatFixed(target, (float)strtod(target, 0x0));
+					break;
+				case DBF_DOUBLE:
+					copyString(target, currentStringValue, true);
+					formatFixed(target, strtod(target, 0x0));
+					break;
+				case DBF_CHAR:
+					copyString(target, currentStringValue, true);
+					formatInteger(target, (char)strtol(target, 0x0, 10));
+					break;
+				case DBF_SHORT:
+					copyString(target, currentStringValue, true);
+					formatInteger(target, (dbr_short_t)strtol(target, 0x0, 10));
+					break;
+				case DBF_LONG:
+					copyString(target, currentStringValue, true);
+					formatInteger(target, (long int)strtol(target, 0x0, 10));
+					break;
+				default:
+					memset(target, 0, MAX_STRING_SIZE);
+					break;
+				}
+			}
+			break;
+		case 1:
+		case 2:
+			if (putType == DBR_STRING) {
+				for (int32 col = 0; col < count; col++) {
+					target = (char*)buffer + col * MAX_STRING_SIZE;
+					if (DataType == 1)
+						formatFixed(target, (float)(**(sDoubleArray2DHdl*)ValueArray2D)->elt[iPos + col]);
+					else
+						formatFixed(target, (**(sDoubleArray2DHdl*)ValueArray2D)->elt[iPos + col]);
+				}
+			}
+			else if (putType == DBR_FLOAT) {
+				narrowValues(&(**(sDoubleArray2DHdl*)ValueArray2D)->elt[iPos], (dbr_float_t*)buffer, count);
+			}
+			else {
+				narrowValues(&(**(sDoubleArray2DHdl*)ValueArray2D)->elt[iPos], (dbr_double_t*)buffer, count);
+			}
+			break;
+		case 3:
+			narrowValues(&(**(sLongArray2DHdl*)ValueArray2D)->elt[iPos], (dbr_char_t*)buffer, count);
+			break;
+		case 4:
+			narrowValues(&(**(sLongArray2DHdl*)ValueArray2D)->elt[iPos], (dbr_short_t*)buffer, count);
+			break;
+		case 5:
+		case 6:
+			if (putType == DBR_DOUBLE)
+				narrowValues(&(**(sLongArray2DHdl*)ValueArray2D)->elt[iPos], (dbr_double_t*)buffer, count);
+			else
+				narrowValues(&(**(sLongArray2DHdl*)ValueArray2D)->elt[iPos], (dbr_long_t*)buffer, count);
+			break;
+		default:
+			;
+		}
+		return putType;
+	}
+
 	// write EPICS PV
 	//    ValueArray2D:       data array (buffer)
 	//    DataType:           data type
@@ -1062,485 +2236,377 @@ public:
 	//		3 = > Byte signed integer = > char = > dbr_char_t
 	//		4 = > Word signed integer = > short = > dbr_short_t
 	//		5 = > Long signed integer = > int = > dbr_long_t
-	//		6 = > Quad signed integer = > long = > dbr_long_t
+	//		6 = > Quad signed integer = > long = > dbr_long_t (dbr_double_t for DBF_DOUBLE or values beyond 32 bits)
 	//    Row:                row in data array
 	//    ValuesPerSet:       numbers of values in row
 	//    Error:              resulting error
 	//    Timeout:            EPICS event timeout in seconds
 	//    Synchronous:        true = callback will be used (no interrupt of motor records)
-	void put(void* ValueArray2D, uInt32 DataType, uInt32 Row, uInt32 ValuesPerSet, sError* Error, double Timeout, bool synchronious) {
-		LStrHandle currentStringValue;
-		char szTmp[MAX_ERROR_SIZE];
+	//    latch:              put group of synchronous putValue call, counted down by putState
+	//                        or immediately if no callback is pending; putState stores status of put at Row
+	// puts are only queued, caller has to flush them with ca_flush_io
+	void put(void* ValueArray2D, uInt32 DataType, uInt32 Row, uInt32 ValuesPerSet, sError* Error, double Timeout, bool synchronious, valueLatchPtr latch = valueLatchPtr()) {
 		uInt32 iResult = ECA_NORMAL;
-		uInt32 iPos = 0;
-		uInt32 ValuesPerSetMax;
-		int32 stringSize;
-		uInt32 size = 0;
+		int32 stringSize = 0;
+		chtype putType = TYPENOTCONN;
 		try {
 			if (stopped || !caID || !*(((bool*)caID) + currentlyConnectedPos)/*ca_state(caID) != cs_conn*/ || !numberOfValues) {
-				if (!stopped) {
-					iResult = ECA_DISCONN;
-					stringSize = (int32)strlen(ca_message(iResult));
-					if (!Error->source || (*Error->source)->cnt != stringSize) {
-						NumericArrayResize(uB, 1, (UHandle*)&Error->source, stringSize);
-						(*Error->source)->cnt = stringSize;
-					}
-					memcpy((*Error->source)->str, ca_message(iResult), stringSize);
-					if (iResult != ECA_NORMAL)
-						Error->code = ERROR_OFFSET + iResult;
-					else
-						Error->code = 0;
-					Error->status = 0;
-				}
+				if (!stopped)
+					putError(Error, ECA_DISCONN);
+				if (latch)
+					latch->countDown();
 				return;
 			}
-			ValuesPerSetMax = numberOfValues;//ca_element_count(caID);
 			tasks.fetch_add(1);
-			putReadBack = false;
-			if (ValuesPerSet > ValuesPerSetMax)
-				stringSize = ValuesPerSetMax;
-			else
-				stringSize = ValuesPerSet;
-			// Create new transfer object (writeValueArray)
-			switch (DataType) {
-			case 0:
-				size = stringSize * MAX_STRING_SIZE * sizeof(char);
-				if (writeValueArraySize != size) {
-					writeValueArray = (char*)realloc(writeValueArray, size);
-					writeValueArraySize = size;
-				}
-				memset(writeValueArray, 0, size);
-				break;
-			case 1:
-				if (nativeType == DBF_STRING) {
-					size = stringSize * MAX_STRING_SIZE * sizeof(char);
-					if (writeValueArraySize != size) {
-						writeValueArray = (char*)realloc(writeValueArray, size);
-						writeValueArraySize = size;
-					}
-					memset(writeValueArray, 0, size);
-				}
-				else {
-					size = stringSize * sizeof(float);
-					if (writeValueArraySize != size) {
-						writeValueArray = (float*)realloc(writeValueArray, size);
-						writeValueArraySize = size;
-					}
-				}
-				break;
-			case 2:
-				if (nativeType == DBF_STRING) {
-					size = stringSize * MAX_STRING_SIZE * sizeof(char);
-					if (writeValueArraySize != size) {
-						writeValueArray = (char*)realloc(writeValueArray, size);
-						writeValueArraySize = size;
-					}
-					memset(writeValueArray, 0, size);
-				}
-				else {
-					size = stringSize * sizeof(double);
-					if (writeValueArraySize != size) {
-						writeValueArray = (double*)realloc(writeValueArray, size);
-						writeValueArraySize = size;
-					}
-				}
-				break;
-			case 3:
-				size = stringSize * sizeof(char);
-				if (writeValueArraySize != size) {
-					writeValueArray = (char*)realloc(writeValueArray, size);
-					writeValueArraySize = size;
-				}
-				break;
-			case 4:
-				size = stringSize * sizeof(short);
-				if (writeValueArraySize != size) {
-					writeValueArray = (short*)realloc(writeValueArray, size);
-					writeValueArraySize = size;
-				}
-				break;
-			case 5:
-			case 6:
-				size = stringSize * sizeof(int);
-				if (writeValueArraySize != size) {
-					writeValueArray = (int*)realloc(writeValueArray, size);
-					writeValueArraySize = size;
-				}
-				break;
-			default:
-				// Handled in previous switch-case statement
-				break;
-			}
-			for (int32 col = 0; col < stringSize; col++) {
-				switch (DataType) {
-				case 0:
-					iPos = Row * ValuesPerSet + col;
-					currentStringValue = (**(sStringArray2DHdl*)ValueArray2D)->elt[iPos];
-					if (currentStringValue) {
-						if ((*currentStringValue)->cnt < MAX_STRING_SIZE - 1) {
-							memcpy(szTmp, (*currentStringValue)->str, (*currentStringValue)->cnt);
-							szTmp[(*currentStringValue)->cnt] = 0x0;
-						}
-					}
-					else {
-						szTmp[0] = 0x0;
-					}
-					if (nativeType != DBF_STRING && nativeType != DBF_ENUM)
-						while (strstr(szTmp, ","))
-							*(strstr(szTmp, ",")) = '.';
-					switch (nativeType) {
-					case DBF_STRING:
-					case DBF_ENUM:
-						memcpy((char*)writeValueArray + col * MAX_STRING_SIZE, szTmp, strlen(szTmp));
-						break;
-					case DBF_FLOAT:
-						if (nativeType == DBF_STRING) {
-							epicsSnprintf((char*)writeValueArray + col * MAX_STRING_SIZE, MAX_STRING_SIZE, "%f", (float)strtod(szTmp, 0x0));
-						}
-						else {
-							epicsSnprintf((char*)writeValueArray + col * MAX_STRING_SIZE, MAX_STRING_SIZE, "%f", (float)strtod(szTmp, 0x0));
-						}
-						break;
-					case DBF_DOUBLE:
-						if (nativeType == DBF_STRING) {
-							currentStringValue = (**(sStringArray2DHdl*)ValueArray2D)->elt[iPos];
-							if (currentStringValue) {
-								if ((*currentStringValue)->cnt < MAX_STRING_SIZE - 1) {
-									memcpy(szTmp, (*currentStringValue)->str, (*currentStringValue)->cnt);
-									szTmp[(*currentStringValue)->cnt] = 0x0;
-								}
-							}
-							else {
-								szTmp[0] = 0x0;
-							}
-							memcpy((char*)writeValueArray + col * MAX_STRING_SIZE, szTmp, strlen(szTmp));
-						}
-						else {
-							epicsSnprintf((char*)writeValueArray + col * MAX_STRING_SIZE, MAX_STRING_SIZE, "%f", (double)strtod(szTmp, 0x0));
-						}
-						break;
-					case DBF_CHAR:
-						epicsSnprintf((char*)writeValueArray + col * MAX_STRING_SIZE, MAX_STRING_SIZE, "%d", (char)strtol(szTmp, 0x0, 10));
-						break;
-					case DBF_SHORT:
-						epicsSnprintf((char*)writeValueArray + col * MAX_STRING_SIZE, MAX_STRING_SIZE, "%d", (dbr_short_t)strtol(szTmp, 0x0, 10));
-						break;
-					case DBF_LONG:
-						epicsSnprintf((char*)writeValueArray + col * MAX_STRING_SIZE, MAX_STRING_SIZE, "%ld", (long int)strtol(szTmp, 0x0, 10));
-						break;
-					default:
-						break;
-					}
-					break;
-				case 1:
-					iPos = Row * ValuesPerSet + col;
-					if (nativeType == DBF_STRING) {
-						epicsSnprintf((char*)writeValueArray + col * MAX_STRING_SIZE, MAX_STRING_SIZE, "%f", (float)(**(sDoubleArray2DHdl*)ValueArray2D)->elt[iPos]);
-					}
-					else {
-						((float*)writeValueArray)[col] = (float)(**(sDoubleArray2DHdl*)ValueArray2D)->elt[iPos];
-					}
-					break;
-				case 2:
-					iPos = Row * ValuesPerSet + col;
-					if (nativeType == DBF_STRING) {
-						epicsSnprintf((char*)writeValueArray + col * MAX_STRING_SIZE, MAX_STRING_SIZE, "%f", (**(sDoubleArray2DHdl*)ValueArray2D)->elt[iPos]);
-					}
-					else {
-						((double*)writeValueArray)[col] = (**(sDoubleArray2DHdl*)ValueArray2D)->elt[iPos];
-					}
-					break;
-				case 3:
-					iPos = Row * ValuesPerSet + col;
-					((char*)writeValueArray)[col] = (char)(**(sLongArray2DHdl*)ValueArray2D)->elt[iPos];
-					break;
-				case 4:
-					iPos = Row * ValuesPerSet + col;
-					((short*)writeValueArray)[col] = (short)(**(sLongArray2DHdl*)ValueArray2D)->elt[iPos];
-					break;
-				case 5:
-				case 6:
-					iPos = Row * ValuesPerSet + col;
-					((int*)writeValueArray)[col] = (int)(**(sLongArray2DHdl*)ValueArray2D)->elt[iPos];
-					break;
-				default:
-					;
-				}
-			}
-			switch (DataType) {
-			case 0:
-				iResult = ca_array_put_callback(DBR_STRING, stringSize, caID, writeValueArray, putState, this);
-				break;
-			case 1:
-				if (nativeType == DBF_STRING) {
-					if (synchronious)
-						iResult = ca_array_put_callback(DBR_STRING, stringSize, caID, writeValueArray, putState, this);
-					else
-						iResult = ca_array_put(DBR_STRING, stringSize, caID, writeValueArray);
-				}
-				else {
-					if (synchronious)
-						iResult = ca_array_put_callback(DBR_FLOAT, stringSize, caID, writeValueArray, putState, this);
-					else
-						iResult = ca_array_put(DBR_FLOAT, stringSize, caID, writeValueArray);
-				}
-				break;
-			case 2:
-				if (nativeType == DBF_STRING) {
-					if (synchronious)
-						iResult = ca_array_put_callback(DBR_STRING, stringSize, caID, writeValueArray, putState, this);
+			putType = convertPut(ValueArray2D, DataType, Row, ValuesPerSet, writeValueArray, writeValueArraySize, stringSize);
+			// strings are always written with callback
+			if (putType != TYPENOTCONN) {
+				if (synchronious || DataType == 0) {
+					// every callback put gets a slot, so putState matches callbacks in order of puts
+					lock();
+					putSlots.push_back(putSlot{ latch, Row, std::chrono::steady_clock::now() });
+					iResult = ca_array_put_callback(putType, stringSize, caID, writeValueArray, putState, this);
+					if (iResult != ECA_NORMAL)
+						putSlots.pop_back();
 					else
-						iResult = ca_array_put(DBR_STRING, stringSize, caID, writeValueArray);
+						latch.reset();
+					unlock();
 				}
 				else {
-					if (synchronious)
-						iResult = ca_array_put_callback(DBR_DOUBLE, stringSize, caID, writeValueArray, putState, this);
-					else
-						iResult = ca_array_put(DBR_DOUBLE, stringSize, caID, writeValueArray);
+					iResult = ca_array_put(putType, stringSize, caID, writeValueArray);
 				}
-				break;
-			case 3:
-				if (synchronious)
-					iResult = ca_array_put_callback(DBR_CHAR, stringSize, caID, writeValueArray, putState, this);
-				else
-					iResult = ca_array_put(DBR_CHAR, stringSize, caID, writeValueArray);
-				break;
-			case 4:
-				if (synchronious)
-					iResult = ca_array_put_callback(DBR_SHORT, stringSize, caID, writeValueArray, putState, this);
-				else
-					iResult = ca_array_put(DBR_SHORT, stringSize, caID, writeValueArray);
-				break;
-			case 5:
-			case 6:
-				if (synchronious)
-					iResult = ca_array_put_callback(DBR_LONG, stringSize, caID, writeValueArray, putState, this);
-				else
-					iResult = ca_array_put(DBR_LONG, stringSize, caID, writeValueArray);
-				break;
-			default:
-				;
-			}
-			stringSize = (int32)strlen(ca_message(iResult));
-			if (!Error->source || (*Error->source)->cnt != stringSize) {
-				NumericArrayResize(uB, 1, (UHandle*)&Error->source, stringSize);
-				(*Error->source)->cnt = stringSize;
+				if (iResult == ECA_NORMAL)
+					putsSent.fetch_add(1, std::memory_order_relaxed);
 			}
-			memcpy((*Error->source)->str, ca_message(iResult), stringSize);
-			if (iResult != ECA_NORMAL)
-				Error->code = ERROR_OFFSET + iResult;
-			else
-				Error->code = 0;
-			Error->status = 0;
+			putError(Error, iResult);
 		}
 		catch (...) {
 			CaLabDbgPrintfD("bad memory access in put");
 			if (locked.load())
 				unlock();
 		}
+		if (latch)
+			latch->countDown();
 		tasks.fetch_sub(1);
 	}
 
-	// post LV user event
-	void postEvent() {
-		/*if (!initConnect) {
-		initConnect = true;
-		return;
+	// get buffer for values of a monitor update (object must be locked)
+	// reuses the previous snapshot as soon as no reader holds it anymore
+	//    type: native data type (DBF_*)
+	//    elementSize: size of single value in bytes
+	//    count: number of values
+	//    returns 0x0 if out of memory
+	valueSnapshot* beginValues(chtype type, size_t elementSize, long count) {
+		if (!nextValues || nextValues.use_count() > 1)
+			nextValues = std::make_shared<valueSnapshot>();
+		if (!nextValues->reserve(elementSize * count)) {
+			CaLabDbgPrintf("Error: Out of memory for values of %s", szName);
+			return 0x0;
+		}
+		nextValues->valueType = type;
+		nextValues->valueCount = (uInt32)count;
+		nextValues->stringsValid = false;
+		if (type == DBF_ENUM)
+			nextValues->enumStrings = sEnum;
+		return nextValues.get();
+	}
+
+	// publish values filled after beginValues (object must be locked)
+	void publishValues() {
+		valueSnapshotPtr previous = std::atomic_exchange(&values, valueSnapshotPtr(nextValues));
+		nextValues = std::const_pointer_cast<valueSnapshot>(previous);
+	}
+
+	// get latest read values, result stays valid while the PV updates
+	valueSnapshotPtr getValues() {
+		return std::atomic_load(&values);
+	}
+
+	// copy values of monitor update in their native data type (object must be locked)
+	//    source: first value of DBR structure
+	//    type: native data type (DBF_*)
+	//    elementSize: size of single value in bytes
+	//    count: number of values
+	void storeValues(const void* source, chtype type, size_t elementSize, long count) {
+		valueSnapshot* target = beginValues(type, elementSize, count);
+		if (!target)
+			return;
+		if (count > 0)
+			memcpy(target->valueArray, source, elementSize * count);
+		publishValues();
+	}
+
+	// publish copy of latest enum values with changed enum strings (object must be locked)
+	void republishEnums() {
+		valueSnapshotPtr current = getValues();
+		if (current && current->valueType == DBF_ENUM)
+			storeValues(current->valueArray, DBF_ENUM, sizeof(dbr_enum_t), current->valueCount);
+	}
+
+	// read latest value as double
+	//    index: position in value buffer
+	double getDouble(uInt32 index) {
+		valueSnapshotPtr current = getValues();
+		return current ? current->getDouble(index) : 0;
+	}
+
+	// copy latest values converted into target type
+	//    target: first element of target array
+	//    count: number of values to copy, missing values are set to 0
+	template<typename T> void copyValues(T* target, uInt32 count) {
+		valueSnapshotPtr current = getValues();
+		if (current)
+			current->copyValues(target, count);
+		else
+			for (uInt32 i = 0; i < count; i++)
+				target[i] = 0;
+	}
+
+	// store numeric values of a DBR_TIME_* update
+	// main items keep native values; field items only show the last value as string in parent's field array
+	//    T: EPICS value type (dbr_*_t)
+	//    Type: native data type (DBF_*)
+	//    args: arguments of value callback
+	//    isField: true if this item is a field of parent
+	template<typename T, chtype Type> MgErr valueUpdate(const evargs& args, bool isField) {
+		const T* values = (const T*)dbr_value_ptr(args.dbr, args.type);
+		if (!isField) {
+			storeValues(values, Type, sizeof(T), args.count);
+			return noErr;
 		}
-		CaLabDbgPrintf("user event of %s", szName);*/
+		if (args.count < 1)
+			return noErr;
+		MgErr err = noErr;
+		char szTmp[MAX_STRING_SIZE];
+		int32 iSize = formatValue(szTmp, (double)values[args.count - 1], Type, sEnum);
+		if ((*(*parent->FieldValueArray)->elt[iFieldID])->cnt != iSize) {
+			err += NumericArrayResize(uB, 1, (UHandle*)&(*parent->FieldValueArray)->elt[iFieldID], iSize);
+			(*(*parent->FieldValueArray)->elt[iFieldID])->cnt = iSize;
+		}
+		memcpy((*(*parent->FieldValueArray)->elt[iFieldID])->str, szTmp, iSize);
+		parent->fieldModified = true;
+		return err;
+	}
+
+	// post LV user event without strings
+	//    RefNum:        LV user event
+	//    result:        event cluster, only members of profile are written
+	//    profile:       payload (PAYLOAD_*)
+	//    current:       latest values
+	//    status:        status of PV belonging to current
+	//    returns POST_DONE, POST_SKIPPED or POST_FAILED
+	uInt32 postNumbers(LVUserEventRef RefNum, sResult* result, uInt32 profile, const valueSnapshotPtr& current, const eventStatus& status) {
+		bool connected = current && current->valueCount;
+		uInt32 count = connected ? current->valueCount : 0;
+		if (profile & PAYLOAD_VALUES) {
+			if (connected) {
+				if ((*result->ValueNumberArray)->dimSize != count) {
+					if (NumericArrayResize(fD, 1, (UHandle*)&result->ValueNumberArray, count) != noErr)
+						return POST_SKIPPED;
+					(*result->ValueNumberArray)->dimSize = count;
+				}
+				current->copyValues((*result->ValueNumberArray)->elt, count);
+			}
+			result->valueArraySize = count;
+		}
+		if (profile & PAYLOAD_STATUS)
+			result->StatusNumber = connected ? status.StatusNumber : (int16_t)epicsAlarmComm;
+		if (profile & PAYLOAD_SEVERITY)
+			result->SeverityNumber = connected ? status.SeverityNumber : (int16_t)epicsSevInvalid;
+		if (profile & PAYLOAD_TIMESTAMP)
+			result->TimeStampNumber = status.TimeStampNumber;
+		if (profile & PAYLOAD_ERROR) {
+			result->ErrorIO.code = connected ? status.ErrorIO.code : ERROR_OFFSET + epicsSevInvalid;
+			result->ErrorIO.status = connected ? status.ErrorIO.status : 0;
+		}
+		return PostLVUserEvent(RefNum, result) == mgNoErr ? POST_DONE : POST_FAILED;
+	}
+
+	// post LV user event with all strings and field arrays
+	//    RefNum:        LV user event
+	//    result:        event cluster
+	//    current:       latest values, strings already formatted
+	//    status:        status of PV belonging to current
+	//    returns POST_DONE or POST_FAILED
+	uInt32 postStrings(LVUserEventRef RefNum, sResult* result, const valueSnapshotPtr& current, const eventStatus& status) {
+		MgErr err = noErr;
+		if (current && current->strings && (*current->strings)->dimSize && result->PVName) {
+			sStringArrayHdl strings = current->strings;
+			size_t count = (*strings)->dimSize;
+			if (!result->StringValueArray || (*result->StringValueArray)->dimSize != count) {
+				if (result->StringValueArray && DSCheckHandle(result->StringValueArray) == noErr)
+					err += DeleteStringArray(result->StringValueArray);
+				result->StringValueArray = (sStringArrayHdl)DSNewHClr(sizeof(size_t) + count * sizeof(LStrHandle[1]));
+				(*result->StringValueArray)->dimSize = count;
+				if (result->ValueNumberArray) {
+					if (DSCheckHandle(result->ValueNumberArray) == noErr)
+						err += DSDisposeHandle(result->ValueNumberArray);
+				}
+				result->ValueNumberArray = (sDoubleArrayHdl)DSNewHClr(sizeof(size_t) + count * sizeof(double[1]));
+				(*result->ValueNumberArray)->dimSize = count;
+			}
+			for (uInt32 j = 0; j < count && j < (*result->StringValueArray)->dimSize; j++) {
+				if ((*strings)->elt[j])
+					err += setString(&(*result->StringValueArray)->elt[j], (const char*)(*(*strings)->elt[j])->str, (*(*strings)->elt[j])->cnt);
+				else
+					err += setString(&(*result->StringValueArray)->elt[j], "\0", 1);
+			}
+			current->copyValues((*result->ValueNumberArray)->elt, (uInt32)(*result->ValueNumberArray)->dimSize);
+			result->valueArraySize = (uInt32)count;
+			if (status.FieldNames.size()) {
+				err += setStrings(&result->FieldNameArray, status.FieldNames);
+				err += setStrings(&result->FieldValueArray, status.FieldValues);
+			}
+			result->TimeStampNumber = status.TimeStampNumber;
+			if (status.TimeStampString.size())
+				err += setString(&result->TimeStampString, status.TimeStampString.data(), (int32)status.TimeStampString.size());
+			if (status.StatusString.size())
+				err += setString(&result->StatusString, status.StatusString.data(), (int32)status.StatusString.size());
+			if (status.SeverityString.size())
+				err += setString(&result->SeverityString, status.SeverityString.data(), (int32)status.SeverityString.size());
+			if (status.ErrorSource.size())
+				err += setString(&result->ErrorIO.source, status.ErrorSource.data(), (int32)status.ErrorSource.size());
+			result->StatusNumber = status.StatusNumber;
+			result->SeverityNumber = status.SeverityNumber;
+			result->ErrorIO.code = status.ErrorIO.code;
+			result->ErrorIO.status = status.ErrorIO.status;
+		}
+		else {
+			err += setString(&result->StatusString, alarmStatusString[epicsAlarmComm], (int32)strlen(alarmStatusString[epicsAlarmComm]));
+			err += setString(&result->SeverityString, alarmSeverityString[epicsSevInvalid], (int32)strlen(alarmSeverityString[epicsSevInvalid]));
+			err += setString(&result->ErrorIO.source, ca_message(ECA_DISCONN), (int32)strlen(ca_message(ECA_DISCONN)));
+			result->StatusNumber = epicsAlarmComm;
+			result->SeverityNumber = epicsSevInvalid;
+			result->ErrorIO.code = ERROR_OFFSET + epicsSevInvalid;
+			result->ErrorIO.status = 0;
+		}
+		if (err)
+			CaLabDbgPrintf("Error: Memory exception in post event of %s", szName);
+		// Post it!
+		return PostLVUserEvent(RefNum, result) == mgNoErr ? POST_DONE : POST_FAILED;
+	}
+
+	// copy status for LV user events (object must be locked)
+	//    status:        target
+	//    strings:       true = copy strings and field arrays too
+	void copyStatus(eventStatus& status, bool strings) {
+		status.StatusNumber = StatusNumber;
+		status.SeverityNumber = SeverityNumber;
+		status.TimeStampNumber = TimeStampNumber;
+		status.ErrorIO.code = ErrorIO.code;
+		status.ErrorIO.status = ErrorIO.status;
+		status.ErrorIO.source = 0x0;
+		if (!strings)
+			return;
+		status.StatusString = toString(StatusString);
+		status.SeverityString = toString(SeverityString);
+		status.TimeStampString = toString(TimeStampString);
+		status.ErrorSource = toString(ErrorIO.source);
+		if (FieldNameArray) {
+			for (uInt32 j = 0; j < (*FieldNameArray)->dimSize; j++) {
+				status.FieldNames.push_back(toString((*FieldNameArray)->elt[j]));
+				status.FieldValues.push_back(FieldValueArray && j < (*FieldValueArray)->dimSize ? toString((*FieldValueArray)->elt[j]) : std::string());
+			}
+		}
+	}
+
+	// post LV user event
+	// subscribers and status are copied under the lock, events are built and posted without it
+	//    deferredOnly: post only updates held back by rate limits
+	void postEvent(bool deferredOnly = false) {
+		std::vector<eventSubscriber> due;
+		std::vector<eventSubscriber> failed;
+		std::vector<eventSubscriber>::iterator it;
+		eventStatus status;
+		uInt32 result;
+		bool wantsStrings = false;
+		uInt32 currentEpoch = eventEpoch.load();
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		double wait;
 		lock();
 		tasks.fetch_add(1);
-		std::vector<LVUserEventRef>::iterator itRefNum;
-		std::vector<sResult*>::iterator itEventResultCluster;
+		valueSnapshotPtr current = getValues();
 		try {
-			MgErr err = noErr;
-			int32 size;
-			itRefNum = RefNum.begin();
-			itEventResultCluster = eventResultCluster.begin();
-			while (itRefNum != RefNum.end() && itEventResultCluster != eventResultCluster.end()) {
-				if (*itRefNum) {
-					if (!*itEventResultCluster
-						|| DSCheckPtr(*itEventResultCluster) != noErr
-						|| !(*itEventResultCluster)->PVName
-						|| DSCheckHandle((*itEventResultCluster)->PVName) != noErr
-						|| !(*itEventResultCluster)->ValueNumberArray
-						|| DSCheckHandle((*itEventResultCluster)->ValueNumberArray) != noErr
-						|| !(*itEventResultCluster)->StringValueArray
-						|| DSCheckHandle((*itEventResultCluster)->StringValueArray) != noErr
-						|| !(*itEventResultCluster)->StatusString
-						|| DSCheckHandle((*itEventResultCluster)->StatusString) != noErr
-						|| !(*itEventResultCluster)->SeverityString
-						|| DSCheckHandle((*itEventResultCluster)->SeverityString) != noErr
-						|| !(*itEventResultCluster)->TimeStampString
-						|| DSCheckHandle((*itEventResultCluster)->TimeStampString) != noErr
-						|| !(*itEventResultCluster)->ErrorIO.source
-						|| DSCheckHandle((*itEventResultCluster)->ErrorIO.source) != noErr
-						|| ((*itEventResultCluster)->FieldNameArray && DSCheckHandle((*itEventResultCluster)->FieldNameArray) != noErr)
-						|| ((*itEventResultCluster)->FieldValueArray && DSCheckHandle((*itEventResultCluster)->FieldValueArray) != noErr)) {
-						itEventResultCluster = eventResultCluster.erase(itEventResultCluster);
-						itRefNum = RefNum.erase(itRefNum);
+			it = eventSubscribers.begin();
+			while (it != eventSubscribers.end()) {
+				if (!it->RefNum) {
+					CaLabDbgPrintf("post event of %s has no reference number", szName);
+					it++;
+					continue;
+				}
+				// handles are validated at registration and again only after LV unloaded or aborted any VI
+				if (it->epoch != currentEpoch) {
+					if (!validResult(it->cluster)) {
+						it = eventSubscribers.erase(it);
 						continue;
 					}
-					if (stringValueArray && *stringValueArray && (*stringValueArray)->dimSize && (*itEventResultCluster)->PVName) {
-						if (!(*itEventResultCluster)->StringValueArray || (*(*itEventResultCluster)->StringValueArray)->dimSize != (*stringValueArray)->dimSize) {
-							if ((*itEventResultCluster)->StringValueArray && DSCheckHandle((*itEventResultCluster)->StringValueArray) == noErr) {
-								for (uInt32 j = 0; j < (*stringValueArray)->dimSize; j++) {
-									DSDisposeHandle((*stringValueArray)->elt[j]);
-								}
-								err += DSDisposeHandle((*itEventResultCluster)->StringValueArray);
-							}
-							(*itEventResultCluster)->StringValueArray = (sStringArrayHdl)DSNewHClr(sizeof(size_t) + (*stringValueArray)->dimSize * sizeof(LStrHandle[1]));
-							(*(*itEventResultCluster)->StringValueArray)->dimSize = (*stringValueArray)->dimSize;
-							if ((*itEventResultCluster)->ValueNumberArray) {
-								if (DSCheckHandle((*itEventResultCluster)->ValueNumberArray) == noErr)
-									err += DSDisposeHandle((*itEventResultCluster)->ValueNumberArray);
-							}
-							(*itEventResultCluster)->ValueNumberArray = (sDoubleArrayHdl)DSNewHClr(sizeof(size_t) + (*stringValueArray)->dimSize * sizeof(double[1]));
-							(*(*itEventResultCluster)->ValueNumberArray)->dimSize = (*stringValueArray)->dimSize;
-						}
-						for (uInt32 j = 0; j < (*stringValueArray)->dimSize && j < (*(*itEventResultCluster)->StringValueArray)->dimSize; j++) {
-							if (!(*(*itEventResultCluster)->StringValueArray)->elt[j] || ((*stringValueArray)->elt[j] && ((*(*(*itEventResultCluster)->StringValueArray)->elt[j])->cnt != (*(*stringValueArray)->elt[j])->cnt))) {
-								err += NumericArrayResize(uB, 1, (UHandle*)&(*(*itEventResultCluster)->StringValueArray)->elt[j], (*stringValueArray)->elt[j] ? (*(*stringValueArray)->elt[j])->cnt : 1);
-								(*(*(*itEventResultCluster)->StringValueArray)->elt[j])->cnt = (*stringValueArray)->elt[j] ? (*(*stringValueArray)->elt[j])->cnt : 1;
-							}
-							if ((*stringValueArray)->elt[j])
-								memcpy((*(*(*itEventResultCluster)->StringValueArray)->elt[j])->str, (*(*stringValueArray)->elt[j])->str, (*(*stringValueArray)->elt[j])->cnt);
-							else
-								memcpy((*(*(*itEventResultCluster)->StringValueArray)->elt[j])->str, "\0", 1);
-							(*(*itEventResultCluster)->ValueNumberArray)->elt[j] = (*doubleValueArray)->elt[j];
-						}
-						(*itEventResultCluster)->valueArraySize = (uInt32)(*stringValueArray)->dimSize;
-						if (FieldNameArray) {
-							if (!(*itEventResultCluster)->FieldNameArray || DSCheckHandle((*itEventResultCluster)->FieldNameArray) != noErr || (FieldNameArray && (!(*itEventResultCluster)->FieldNameArray || (*(*itEventResultCluster)->FieldNameArray)->dimSize != (*FieldNameArray)->dimSize))) {
-								if ((*itEventResultCluster)->FieldNameArray && DSCheckHandle((*itEventResultCluster)->FieldNameArray) == noErr)
-									err += DSDisposeHandle((*itEventResultCluster)->FieldNameArray);
-								(*itEventResultCluster)->FieldNameArray = (sStringArrayHdl)DSNewHClr(sizeof(size_t) + (*FieldNameArray)->dimSize * sizeof(LStrHandle[1]));
-								(*(*itEventResultCluster)->FieldNameArray)->dimSize = (*FieldNameArray)->dimSize;
-							}
-							for (uInt32 j = 0; FieldNameArray && j < (*FieldNameArray)->dimSize && j < (*(*itEventResultCluster)->FieldNameArray)->dimSize; j++) {
-								if (!(*(*itEventResultCluster)->FieldNameArray)->elt[j] || ((*FieldNameArray)->elt[j] && ((*(*(*itEventResultCluster)->FieldNameArray)->elt[j])->cnt != (*(*FieldNameArray)->elt[j])->cnt))) {
-									err += NumericArrayResize(uB, 1, (UHandle*)&(*(*itEventResultCluster)->FieldNameArray)->elt[j], (*FieldNameArray)->elt[j] ? (*(*FieldNameArray)->elt[j])->cnt : 1);
-									(*(*(*itEventResultCluster)->FieldNameArray)->elt[j])->cnt = (*FieldNameArray)->elt[j] ? (*(*FieldNameArray)->elt[j])->cnt : 1;
-								}
-								if ((*FieldNameArray)->elt[j])
-									memcpy((*(*(*itEventResultCluster)->FieldNameArray)->elt[j])->str, (*(*FieldNameArray)->elt[j])->str, (*(*FieldNameArray)->elt[j])->cnt);
-								else
-									memcpy((*(*(*itEventResultCluster)->FieldNameArray)->elt[j])->str, "\0", 1);
-							}
-							if (!(*itEventResultCluster)->FieldValueArray || DSCheckHandle((*itEventResultCluster)->FieldValueArray) != noErr || (FieldNameArray && (!(*itEventResultCluster)->FieldValueArray || (*(*itEventResultCluster)->FieldValueArray)->dimSize != (*FieldNameArray)->dimSize))) {
-								if ((*itEventResultCluster)->FieldValueArray && DSCheckHandle((*itEventResultCluster)->FieldValueArray) == noErr)
-									err += DSDisposeHandle((*itEventResultCluster)->FieldValueArray);
-								(*itEventResultCluster)->FieldValueArray = (sStringArrayHdl)DSNewHClr(sizeof(size_t) + (*FieldNameArray)->dimSize * sizeof(LStrHandle[1]));
-								(*(*itEventResultCluster)->FieldValueArray)->dimSize = (*FieldNameArray)->dimSize;
-							}
-							for (uInt32 j = 0; FieldValueArray && j < (*FieldValueArray)->dimSize && j < (*(*itEventResultCluster)->FieldValueArray)->dimSize; j++) {
-								if (!(*(*itEventResultCluster)->FieldValueArray)->elt[j] || ((*FieldValueArray)->elt[j] && ((*(*(*itEventResultCluster)->FieldValueArray)->elt[j])->cnt != (*(*FieldValueArray)->elt[j])->cnt))) {
-									err += NumericArrayResize(uB, 1, (UHandle*)&(*(*itEventResultCluster)->FieldValueArray)->elt[j], (*FieldValueArray)->elt[j] ? (*(*FieldValueArray)->elt[j])->cnt : 1);
-									(*(*(*itEventResultCluster)->FieldValueArray)->elt[j])->cnt = (*FieldValueArray)->elt[j] ? (*(*FieldValueArray)->elt[j])->cnt : 1;
-								}
-								if ((*FieldValueArray)->elt[j])
-									memcpy((*(*(*itEventResultCluster)->FieldValueArray)->elt[j])->str, (*(*FieldValueArray)->elt[j])->str, (*(*FieldValueArray)->elt[j])->cnt);
-								else
-									memcpy((*(*(*itEventResultCluster)->FieldValueArray)->elt[j])->str, "\0", 1);
-							}
-						}
-						(*itEventResultCluster)->TimeStampNumber = TimeStampNumber;
-						if (TimeStampString) {
-							if (!(*itEventResultCluster)->TimeStampString || (*(*itEventResultCluster)->TimeStampString)->cnt != (*TimeStampString)->cnt) {
-								NumericArrayResize(uB, 1, (UHandle*)&(*itEventResultCluster)->TimeStampString, (*TimeStampString)->cnt);
-								(*(*itEventResultCluster)->TimeStampString)->cnt = (*TimeStampString)->cnt;
-							}
-							memcpy((*(*itEventResultCluster)->TimeStampString)->str, (*TimeStampString)->str, (*TimeStampString)->cnt);
-						}
-						if (StatusString) {
-							if (!(*itEventResultCluster)->StatusString || (*(*itEventResultCluster)->StatusString)->cnt != (*StatusString)->cnt) {
-								NumericArrayResize(uB, 1, (UHandle*)&(*itEventResultCluster)->StatusString, (*StatusString)->cnt);
-								(*(*itEventResultCluster)->StatusString)->cnt = (*StatusString)->cnt;
-							}
-							memcpy((*(*itEventResultCluster)->StatusString)->str, (*StatusString)->str, (*StatusString)->cnt);
-						}
-						if (SeverityString) {
-							if (!(*itEventResultCluster)->SeverityString || (*(*itEventResultCluster)->SeverityString)->cnt != (*SeverityString)->cnt) {
-								NumericArrayResize(uB, 1, (UHandle*)&(*itEventResultCluster)->SeverityString, (*SeverityString)->cnt);
-								(*(*itEventResultCluster)->SeverityString)->cnt = (*SeverityString)->cnt;
-							}
-							memcpy((*(*itEventResultCluster)->SeverityString)->str, (*SeverityString)->str, (*SeverityString)->cnt);
-						}
-						if (ErrorIO.source) {
-							if (!(*itEventResultCluster)->ErrorIO.source || (*(*itEventResultCluster)->ErrorIO.source)->cnt != (*ErrorIO.source)->cnt) {
-								NumericArrayResize(uB, 1, (UHandle*)&(*itEventResultCluster)->ErrorIO.source, (*ErrorIO.source)->cnt);
-								(*(*itEventResultCluster)->ErrorIO.source)->cnt = (*ErrorIO.source)->cnt;
-							}
-							memcpy((*(*itEventResultCluster)->ErrorIO.source)->str, (*ErrorIO.source)->str, (*ErrorIO.source)->cnt);
-						}
-						(*itEventResultCluster)->StatusNumber = StatusNumber;
-						(*itEventResultCluster)->SeverityNumber = SeverityNumber;
-						(*itEventResultCluster)->ErrorIO.code = ErrorIO.code;
-						(*itEventResultCluster)->ErrorIO.status = ErrorIO.status;
-						// Post it!
-						if (PostLVUserEvent(*itRefNum, *itEventResultCluster) != mgNoErr) {
-							itRefNum = RefNum.erase(itRefNum);
-							itEventResultCluster = eventResultCluster.erase((itEventResultCluster));
-							continue;
-						}
+					it->epoch = currentEpoch;
+				}
+				if (it->limit.interval > 0 || deferredOnly) {
+					wait = deferredOnly && !it->limit.pending ? -1 : it->limit.interval > 0 ? it->limit.take(now) : 0;
+					if (wait > 0) {
+						if (it->limit.pending)
+							eventsCoalesced.fetch_add(1, std::memory_order_relaxed);
+						it->limit.pending = true;
+						deferEvent(this, now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(wait)));
 					}
-					else {
-						size = (int32)strlen(alarmStatusString[epicsAlarmComm]);
-						if (!(*itEventResultCluster)->StatusString || (*(*itEventResultCluster)->StatusString)->cnt != size) {
-							NumericArrayResize(uB, 1, (UHandle*)&(*itEventResultCluster)->StatusString, size);
-							(*(*itEventResultCluster)->StatusString)->cnt = size;
-						}
-						memcpy((*(*itEventResultCluster)->StatusString)->str, alarmStatusString[epicsAlarmComm], size);
-						size = (int32)strlen(alarmSeverityString[epicsSevInvalid]);
-						if (!(*itEventResultCluster)->SeverityString || (*(*itEventResultCluster)->SeverityString)->cnt != size) {
-							NumericArrayResize(uB, 1, (UHandle*)&(*itEventResultCluster)->SeverityString, size);
-							(*(*itEventResultCluster)->SeverityString)->cnt = size;
-						}
-						memcpy((*(*itEventResultCluster)->SeverityString)->str, alarmSeverityString[epicsSevInvalid], size);
-						if (!(*itEventResultCluster)->ErrorIO.source || (*(*itEventResultCluster)->ErrorIO.source)->cnt != (*ErrorIO.source)->cnt) {
-							NumericArrayResize(uB, 1, (UHandle*)&(*itEventResultCluster)->ErrorIO.source, (*ErrorIO.source)->cnt);
-							(*(*itEventResultCluster)->ErrorIO.source)->cnt = (*ErrorIO.source)->cnt;
-						}
-						if (!(*itEventResultCluster)->ErrorIO.source || (*(*itEventResultCluster)->ErrorIO.source)->cnt != (int32)strlen(ca_message(ECA_DISCONN))) {
-							NumericArrayResize(uB, 1, (UHandle*)&(*itEventResultCluster)->ErrorIO.source, strlen(ca_message(ECA_DISCONN)));
-							(*(*itEventResultCluster)->ErrorIO.source)->cnt = (int32)strlen(ca_message(ECA_DISCONN));
-						}
-						memcpy((*(*itEventResultCluster)->ErrorIO.source)->str, ca_message(ECA_DISCONN), strlen(ca_message(ECA_DISCONN)));
-						(*itEventResultCluster)->StatusNumber = epicsAlarmComm;
-						(*itEventResultCluster)->SeverityNumber = epicsSevInvalid;
-						(*itEventResultCluster)->ErrorIO.code = ERROR_OFFSET + epicsSevInvalid;
-						(*itEventResultCluster)->ErrorIO.status = 0;
-						// Post it!
-						if (PostLVUserEvent(*itRefNum, *itEventResultCluster) != mgNoErr) {
-							itRefNum = RefNum.erase(itRefNum);
-							itEventResultCluster = eventResultCluster.erase((itEventResultCluster));
-							continue;
-						}
+					if (wait != 0) {
+						it++;
+						continue;
 					}
-					itRefNum++;
-					itEventResultCluster++;
-				}
-				else {
-					itRefNum++;
-					itEventResultCluster++;
-					CaLabDbgPrintf("post event of %s has no reference number", szName);
+					it->limit.pending = false;
 				}
+				if (it->profile & PAYLOAD_STRINGS)
+					wantsStrings = true;
+				due.push_back(*it);
+				it++;
 			}
+			copyStatus(status, wantsStrings);
 		}
 		catch (...) {
 			CaLabDbgPrintfD("bad memory access in post event");
-			itRefNum = RefNum.begin();
-			while (itRefNum != RefNum.end()) {
-				itRefNum = RefNum.erase(itRefNum);
+			eventSubscribers.clear();
+			due.clear();
+		}
+		unlock();
+		if (due.size()) {
+			// clusters of the same PV are written by one thread at a time
+			epicsMutexLock(postLock);
+			try {
+				// strings are formatted only for subscribers which want them
+				if (wantsStrings && current)
+					current->formatStrings();
+				for (it = due.begin(); it != due.end(); ++it) {
+					result = it->profile & PAYLOAD_STRINGS ? postStrings(it->RefNum, it->cluster, current, status) : postNumbers(it->RefNum, it->cluster, it->profile, current, status);
+					if (result == POST_DONE) {
+						eventsPosted.fetch_add(1, std::memory_order_relaxed);
+						continue;
+					}
+					eventsDropped.fetch_add(1, std::memory_order_relaxed);
+					if (result == POST_FAILED)
+						failed.push_back(*it);
+				}
 			}
-			itEventResultCluster = eventResultCluster.begin();
-			while (itEventResultCluster != eventResultCluster.end()) {
-				itEventResultCluster = eventResultCluster.erase(itEventResultCluster);
+			catch (...) {
+				CaLabDbgPrintfD("bad memory access in post event");
+				failed = due;
+			}
+			epicsMutexUnlock(postLock);
+		}
+		if (failed.size()) {
+			// subscribers are removed after their event could not be posted
+			lock();
+			for (std::vector<eventSubscriber>::iterator itFailed = failed.begin(); itFailed != failed.end(); ++itFailed) {
+				for (it = eventSubscribers.begin(); it != eventSubscribers.end(); ++it) {
+					if (it->RefNum == itFailed->RefNum && it->cluster == itFailed->cluster) {
+						eventSubscribers.erase(it);
+						break;
+					}
+				}
 			}
+			unlock();
 		}
 		tasks.fetch_sub(1);
-		unlock();
-		return;
 	}
 };
 
@@ -1552,11 +2618,11 @@ public:
 	epicsMutexId 			myLock;           // list mutex
 	std::atomic<uInt32> 	numberOfItems;    // number of list items (data objects)
 	std::atomic<bool>		locked;			  // indicator of locked list
+	std::vector<calabItem*>	hashTable;        // open addressing index of list items (key: PV name)
 
 	calabItemList() {
 		caLabLoad();
 		myLock = epicsMutexCreate();
-		getLock = epicsMutexCreate();
 		numberOfItems = 0;
 		locked = false;
 	}
@@ -1564,6 +2630,14 @@ public:
 	~calabItemList() {
 		uInt32 timeout = 1000;
 		stopped = true;
+		if (jobEvent)
+			epicsEventSignal(jobEvent);
+		if (teardownEvent)
+			epicsEventSignal(teardownEvent);
+		if (putEvent)
+			epicsEventSignal(putEvent);
+		if (dispatchEvent)
+			epicsEventSignal(dispatchEvent);
 		while (timeout > 0 && tasks.load() > 0) {
 			epicsThreadSleep(.01);
 			timeout--;
@@ -1587,8 +2661,51 @@ public:
 			printf("Error: Corrupted internal list of items.");
 		}
 		epicsMutexDestroy(myLock);
-		epicsMutexDestroy(getLock);
+		if (jobEvent)
+			epicsEventDestroy(jobEvent);
+		if (jobLock)
+			epicsMutexDestroy(jobLock);
+		if (teardownEvent)
+			epicsEventDestroy(teardownEvent);
+		if (teardownLock)
+			epicsMutexDestroy(teardownLock);
+		if (putEvent)
+			epicsEventDestroy(putEvent);
+		delete putQueue;
+		putQueue = 0x0;
+		if (dispatchEvent)
+			epicsEventDestroy(dispatchEvent);
+		delete dispatchQueue;
+		dispatchQueue = 0x0;
+		clearBatchEvents();
+		if (deferLock) {
+			epicsMutexDestroy(deferLock);
+			deferLock = 0x0;
+		}
+		deferredEvents.clear();
+		if (deliveryLock) {
+			epicsMutexLock(deliveryLock);
+			deliveries.clear();
+			epicsMutexUnlock(deliveryLock);
+			epicsMutexDestroy(deliveryLock);
+			deliveryLock = 0x0;
+		}
 		ca_context_destroy();
+		// put callbacks may release buffers until Channel Access is gone
+		if (bufferLock) {
+			epicsMutexLock(bufferLock);
+			for (std::vector<asyncPut*>::iterator it = freePuts.begin(); it != freePuts.end(); ++it)
+				delete *it;
+			freePuts.clear();
+			for (uInt32 i = 0; i < BUFFER_CLASSES; i++) {
+				for (std::vector<void*>::iterator it = freeBuffers[i].begin(); it != freeBuffers[i].end(); ++it)
+					free(*it);
+				freeBuffers[i].clear();
+			}
+			epicsMutexUnlock(bufferLock);
+			epicsMutexDestroy(bufferLock);
+			bufferLock = 0x0;
+		}
 		caLabUnload();
 	}
 
@@ -1618,6 +2735,67 @@ public:
 		locked = false;
 	}
 
+	// FNV-1a hash of PV name
+	//    str: PV name (not null-terminated)
+	//    cnt: length of PV name
+	//    return: hash value
+	static uInt32 hash(const uChar* str, int32 cnt) {
+		uInt32 value = 2166136261u;
+		for (int32 i = 0; i < cnt; i++) {
+			value ^= str[i];
+			value *= 16777619u;
+		}
+		return value;
+	}
+
+	// look up data object by PV name (list must be locked)
+	//    str: PV name (not null-terminated)
+	//    cnt: length of PV name
+	//    return: pointer to found data object or null
+	calabItem* find(const uChar* str, int32 cnt) {
+		if (hashTable.empty())
+			return 0x0;
+		size_t mask = hashTable.size() - 1;
+		for (size_t pos = hash(str, cnt) & mask; hashTable[pos]; pos = (pos + 1) & mask) {
+			if ((*hashTable[pos]->name)->cnt == cnt && memcmp((*hashTable[pos]->name)->str, str, cnt) == 0)
+				return hashTable[pos];
+		}
+		return 0x0;
+	}
+
+	// append data object to list and index (list must be locked)
+	//    item: new data object
+	void append(calabItem* item) {
+		item->previous = lastItem;
+		if (lastItem)
+			lastItem->next = item;
+		if (!firstItem)
+			firstItem = item;
+		lastItem = item;
+		numberOfItems.fetch_add(1);
+		// keep load factor of index below 50%
+		if (numberOfItems.load() * 2 > hashTable.size()) {
+			std::vector<calabItem*> oldTable;
+			oldTable.swap(hashTable);
+			hashTable.assign(oldTable.empty() ? 1024 : oldTable.size() * 2, (calabItem*)0x0);
+			for (size_t i = 0; i < oldTable.size(); i++) {
+				if (oldTable[i])
+					insert(oldTable[i]);
+			}
+		}
+		insert(item);
+	}
+
+	// insert data object into index (list must be locked)
+	//    item: data object
+	void insert(calabItem* item) {
+		size_t mask = hashTable.size() - 1;
+		size_t pos = hash((*item->name)->str, (*item->name)->cnt) & mask;
+		while (hashTable[pos])
+			pos = (pos + 1) & mask;
+		hashTable[pos] = item;
+	}
+
 	// add new data object if not exists
 	//    name: EPICS variable name
 	//    FieldNameArray: field names of interest of current EPICS variable
@@ -1625,41 +2803,30 @@ public:
 	calabItem* add(LStrHandle name, sStringArrayHdl FieldNameArray = 0x0) {
 		lock();
 		LStrHandle fullFieldName = 0x0;
-		calabItem* currentItem = firstItem;
-		calabItem* currentFieldItem = 0x0;
+		calabItem* currentItem = find((*name)->str, (*name)->cnt);
 		calabItem* fieldItem;
-		while (currentItem) {
-			if ((*currentItem->name)->cnt == (*name)->cnt && strncmp((const char*)(*currentItem->name)->str, (const char*)(*name)->str, (*name)->cnt) == 0) {
-				break;
-			}
-			currentItem = currentItem->next;
-		}
 		if (!currentItem) {
 			currentItem = new calabItem(name, FieldNameArray);
-			currentItem->previous = lastItem;
-			if (lastItem)
-				lastItem->next = currentItem;
-			if (!firstItem)
-				firstItem = currentItem;
-			lastItem = currentItem;
-			numberOfItems.fetch_add(1);
+			append(currentItem);
+			postJob(currentItem, JOB_CREATE);
 		}
 		if (currentItem && FieldNameArray && *FieldNameArray) {
 			if (!currentItem->FieldNameArray || !*currentItem->FieldNameArray) {
+				// build field arrays first and publish them under the item lock (concurrent readers)
 				char szFieldName[MAX_NAME_SIZE];
-				currentItem->FieldNameArray = (sStringArrayHdl)DSNewHClr(sizeof(size_t) + (*FieldNameArray)->dimSize * sizeof(LStrHandle[1]));
-				(*currentItem->FieldNameArray)->dimSize = (*FieldNameArray)->dimSize;
-				currentItem->FieldValueArray = (sStringArrayHdl)DSNewHClr(sizeof(size_t) + (*FieldNameArray)->dimSize * sizeof(LStrHandle[1]));
-				(*currentItem->FieldValueArray)->dimSize = (*FieldNameArray)->dimSize;
+				sStringArrayHdl newFieldNameArray = (sStringArrayHdl)DSNewHClr(sizeof(size_t) + (*FieldNameArray)->dimSize * sizeof(LStrHandle[1]));
+				(*newFieldNameArray)->dimSize = (*FieldNameArray)->dimSize;
+				sStringArrayHdl newFieldValueArray = (sStringArrayHdl)DSNewHClr(sizeof(size_t) + (*FieldNameArray)->dimSize * sizeof(LStrHandle[1]));
+				(*newFieldValueArray)->dimSize = (*FieldNameArray)->dimSize;
 				for (uInt32 i = 0; i < (*FieldNameArray)->dimSize; i++) {
-					NumericArrayResize(uB, 1, (UHandle*)&(*currentItem->FieldNameArray)->elt[i], (*(*FieldNameArray)->elt[i])->cnt);
-					(*(*currentItem->FieldNameArray)->elt[i])->cnt = (*(*FieldNameArray)->elt[i])->cnt;
-					memcpy((*(*currentItem->FieldNameArray)->elt[i])->str, (*(*FieldNameArray)->elt[i])->str, (*(*FieldNameArray)->elt[i])->cnt);
-					NumericArrayResize(uB, 1, (UHandle*)&(*currentItem->FieldValueArray)->elt[i], 0);
-					(*(*currentItem->FieldValueArray)->elt[i])->cnt = 0;
+					NumericArrayResize(uB, 1, (UHandle*)&(*newFieldNameArray)->elt[i], (*(*FieldNameArray)->elt[i])->cnt);
+					(*(*newFieldNameArray)->elt[i])->cnt = (*(*FieldNameArray)->elt[i])->cnt;
+					memcpy((*(*newFieldNameArray)->elt[i])->str, (*(*FieldNameArray)->elt[i])->str, (*(*FieldNameArray)->elt[i])->cnt);
+					NumericArrayResize(uB, 1, (UHandle*)&(*newFieldValueArray)->elt[i], 0);
+					(*(*newFieldValueArray)->elt[i])->cnt = 0;
 					// White spaces in field names are not allowed
-					memcpy(szFieldName, (*(*currentItem->FieldNameArray)->elt[i])->str, (*(*currentItem->FieldNameArray)->elt[i])->cnt);
-					szFieldName[(*(*currentItem->FieldNameArray)->elt[i])->cnt] = 0x0;
+					memcpy(szFieldName, (*(*newFieldNameArray)->elt[i])->str, (*(*newFieldNameArray)->elt[i])->cnt);
+					szFieldName[(*(*newFieldNameArray)->elt[i])->cnt] = 0x0;
 					if (strchr(szFieldName, ' ') || strchr(szFieldName, '\t')) {
 						if (strchr(szFieldName, ' ')) {
 							DbgTime(); CaLabDbgPrintf("white space in field name \"%s\" detected", szFieldName);
@@ -1669,11 +2836,15 @@ public:
 							DbgTime(); CaLabDbgPrintf("tabulator in field name \"%s\" detected", szFieldName);
 							*(strchr(szFieldName, '\t')) = 0;
 						}
-						NumericArrayResize(uB, 1, (UHandle*)&(*currentItem->FieldNameArray)->elt[i], strlen(szFieldName));
-						memcpy((*(*currentItem->FieldNameArray)->elt[i])->str, szFieldName, strlen(szFieldName));
-						(*(*currentItem->FieldNameArray)->elt[i])->cnt = (int32)strlen(szFieldName);
+						NumericArrayResize(uB, 1, (UHandle*)&(*newFieldNameArray)->elt[i], strlen(szFieldName));
+						memcpy((*(*newFieldNameArray)->elt[i])->str, szFieldName, strlen(szFieldName));
+						(*(*newFieldNameArray)->elt[i])->cnt = (int32)strlen(szFieldName);
 					}
 				}
+				currentItem->lock();
+				currentItem->FieldNameArray = newFieldNameArray;
+				currentItem->FieldValueArray = newFieldValueArray;
+				currentItem->unlock();
 			}
 			for (uInt32 i = 0; FieldNameArray && *FieldNameArray && i < (*FieldNameArray)->dimSize; i++) {
 				NumericArrayResize(uB, 1, (UHandle*)&fullFieldName, (*name)->cnt + 1 + (*(*FieldNameArray)->elt[i])->cnt);
@@ -1681,24 +2852,15 @@ public:
 				memcpy((*fullFieldName)->str + (*name)->cnt, ".", 1);
 				memcpy((*fullFieldName)->str + (*name)->cnt + 1, (*(*FieldNameArray)->elt[i])->str, (*(*FieldNameArray)->elt[i])->cnt);
 				(*fullFieldName)->cnt = (*name)->cnt + 1 + (*(*FieldNameArray)->elt[i])->cnt;
-				currentFieldItem = firstItem;
-				while (currentFieldItem) {
-					if ((*currentFieldItem->name)->cnt == (*fullFieldName)->cnt && strncmp((const char*)(*currentFieldItem->name)->str, (const char*)(*fullFieldName)->str, (*fullFieldName)->cnt) == 0) {
-						break;
-					}
-					currentFieldItem = currentFieldItem->next;
-				}
-				if (!currentFieldItem) {
+				if (!find((*fullFieldName)->str, (*fullFieldName)->cnt)) {
 					fieldItem = new calabItem(fullFieldName, 0x0);
-					fieldItem->previous = lastItem;
 					fieldItem->parent = currentItem;
 					fieldItem->iFieldID = i;
-					if (lastItem)
-						lastItem->next = fieldItem;
-					if (!firstItem)
-						firstItem = fieldItem;
-					lastItem = fieldItem;
-					numberOfItems.fetch_add(1);
+					append(fieldItem);
+					postJob(fieldItem, JOB_CREATE);
+					currentItem->lock();
+					currentItem->fieldItems.push_back(fieldItem);
+					currentItem->unlock();
 				}
 			}
 			if (fullFieldName) {
@@ -1710,6 +2872,28 @@ public:
 	}
 } myItems;
 
+// let caTask send queued puts
+// putValue runs on LV threads without CA context, where ca_flush_io would create a private context
+void requestFlush() {
+	flushRequested = true;
+	epicsEventSignal(jobEvent);
+}
+
+// hand over job of data object to caTask
+//    item: data object
+//    job:  JOB_* bit(s)
+void postJob(calabItem* item, uInt32 job) {
+	if (!jobLock || stopped)
+		return;
+	// queue data object only once, caTask takes all pending jobs at once
+	if (item->jobs.fetch_or(job))
+		return;
+	epicsMutexLock(jobLock);
+	jobQueue.push_back(item);
+	epicsMutexUnlock(jobLock);
+	epicsEventSignal(jobEvent);
+}
+
 // error handler for segfault 
 void signalHandler(int signum) {
 	switch (signum) {
@@ -1847,6 +3031,8 @@ extern "C" EXPORT MgErr reserved(InstanceDataPtr *instanceState) {
 // callback of LV when any caLab-VI is unloaded
 //    instanceState: undocumented pointer
 extern "C" EXPORT MgErr unreserved(InstanceDataPtr *instanceState) {
+	// handles of registered user events may be gone, postEvent validates them once again
+	eventEpoch.fetch_add(1);
 	return 0;
 }
 
@@ -1894,8 +3080,13 @@ void valueChanged(evargs args) {
 		return;
 	try {
 		calabItem *item = (calabItem *)ca_puser(args.chid);
-		if (item)
+		if (item) {
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
 			item->itemValueChanged(args);
+			double duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			item->callbackLast.store(duration, std::memory_order_relaxed);
+			storeMax(item->callbackMax, duration);
+		}
 	}
 	catch (...) {
 		CaLabDbgPrintfD("Exception in value changed callback");
@@ -1909,151 +3100,216 @@ void putState(evargs args) {
 	if (stopped)
 		return;
 	calabItem *item = (calabItem *)ca_puser(args.chid);
-	if (item)
-		item->putReadBack = true;
+	if (!item)
+		return;
+	valueLatchPtr latch;
+	double latency;
+	item->lock();
+	if (item->putSlotsHead < item->putSlots.size()) {
+		putSlot& slot = item->putSlots[item->putSlotsHead++];
+		latch.swap(slot.latch);
+		if (latch && slot.row < latch->status.size())
+			latch->status[slot.row] = args.status;
+		latency = std::chrono::duration<double>(std::chrono::steady_clock::now() - slot.issued).count();
+		item->putLatencyLast.store(latency, std::memory_order_relaxed);
+		storeMax(item->putLatencyMax, latency);
+		// keep capacity of putSlots, finished puts are removed without new allocation
+		if (item->putSlotsHead == item->putSlots.size()) {
+			item->putSlots.clear();
+			item->putSlotsHead = 0;
+		}
+		else if (item->putSlotsHead * 2 >= item->putSlots.size()) {
+			item->putSlots.erase(item->putSlots.begin(), item->putSlots.begin() + item->putSlotsHead);
+			item->putSlotsHead = 0;
+		}
+	}
+	item->unlock();
+	// last callback of put group wakes putValue
+	if (latch)
+		latch->countDown();
+}
+
+// post completion of asynchronous put as LV user event
+//    job: finished put
+//    status: EPICS status of put
+void postPutResult(asyncPut* job, int32 status) {
+	if (!job->notify)
+		return;
+	sPutResult result;
+	int32 size;
+	memset(&result, 0, sizeof(result));
+	job->item->lock();
+	if (job->item->name) {
+		size = (*job->item->name)->cnt;
+		NumericArrayResize(uB, 1, (UHandle*)&result.PVName, size);
+		(*result.PVName)->cnt = size;
+		memcpy((*result.PVName)->str, (*job->item->name)->str, size);
+	}
+	job->item->putError(&result.ErrorIO, status);
+	job->item->unlock();
+	if (PostLVUserEvent(job->RefNum, &result) != mgNoErr) {
+		CaLabDbgPrintfD("could not post completion of put");
+	}
+	if (result.PVName)
+		DSDisposeHandle(result.PVName);
+	if (result.ErrorIO.source)
+		DSDisposeHandle(result.ErrorIO.source);
+}
 
+// callback for finished asynchronous put
+//    args:   contains job of caPutTask
+void putDone(evargs args) {
+	asyncPut* job = (asyncPut*)args.usr;
+	if (!job)
+		return;
+	try {
+		// no LV user events while library terminates, job is released anyway
+		if (!stopped)
+			postPutResult(job, args.status);
+	}
+	catch (...) {
+		CaLabDbgPrintfD("Exception in put callback");
+	}
+	releasePut(job);
 }
 
-// check whether all data objects got values
+// wait until all data objects got values or are known as missing
 //    maxNumberOfValues: maximum number of values in single array across all read arrays
 //    PvIndexArray: Pointer array of data objects
-//    Timeout: time out for check values
-//    all: ignore PvIndexArray and check full list of known data objects
-void wait4value(uInt32 &maxNumberOfValues, sLongArrayHdl* PvIndexArray, time_t Timeout, bool all = false) {
-	time_t stop = time(nullptr) + Timeout;
+//    Timeout: time out for check values in seconds (fractions are used)
+//    all: check field objects of requested data objects too
+//    poll: read values once (batched gets) instead of monitoring them
+void wait4value(uInt32 &maxNumberOfValues, sLongArrayHdl* PvIndexArray, double Timeout, bool all = false, bool poll = false) {
+	std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now() + std::chrono::microseconds((int64_t)(Timeout * 1e6));
 	calabItem* currentItem;
-	calabItem* checkItem;
-	time_t timeout;
-	uInt32 counter;
-	bool isFirstRun = true;
-	bool isRequested = false;
-	char* pIndicator = 0x0;
-	int pos = 0;
-	while ((timeout = time(nullptr)) < stop) {
-		counter = 1;
-		maxNumberOfValues = 0;
+	valueLatchPtr latch = std::make_shared<valueLatch>();
+	maxNumberOfValues = 0;
+	for (uInt32 i = 0; i < (**PvIndexArray)->dimSize; i++) {
+		currentItem = (calabItem*)(**PvIndexArray)->elt[i];
+		if (!valid(currentItem)) {
+			DbgTime(); CaLabDbgPrintf("Error in wait4value: Index array is corrupted.");
+			continue;
+		}
+		if (poll)
+			currentItem->poll();
+		else
+			currentItem->activate();
+		currentItem->lock();
 		if (all) {
-			myItems.lock();
-			currentItem = myItems.firstItem;
-			while (currentItem) {
-				if (!valid(currentItem)) {
-					DbgTime(); CaLabDbgPrintf("Error in wait4value all: Index array is corrupted.");
-					currentItem = currentItem->next;
-					continue;
-				}
-				isRequested = false;
-				for (uInt32 i = 0; i < (**PvIndexArray)->dimSize; i++) {
-					checkItem = (calabItem*)(**PvIndexArray)->elt[i];
-					if (!valid(checkItem))
-						continue;
-					if (currentItem == checkItem) {
-						isRequested = true;
-						break;
-					}
-					if (currentItem->parent) {
-						pIndicator = strchr(currentItem->szName, '.');
-						pos = (int)(strlen(currentItem->szName) - (pIndicator - currentItem->szName));
-						if (strncmp((const char*)(*currentItem->name)->str, (const char*)(*checkItem->name)->str, (*checkItem->name)->cnt - pos) == 0) {
-							isRequested = true;
-							break;
-						}
-					}
-				}
-				if (isFirstRun) {
-					if (isRequested) {
-						currentItem->isPassive = false;
-						//CaLabDbgPrintfD("%s is requested", currentItem->szName);
-					}
-				}
-				else {
-					if (currentItem->hasValue) {
-						if (!currentItem->parent) {
-							if (isRequested)
-								counter++;
-							currentItem->lock();
-							if (isRequested && currentItem->numberOfValues > maxNumberOfValues)
-								maxNumberOfValues = currentItem->numberOfValues;
-							currentItem->unlock();
-						}
-					}
-					else {
-						//break;
-					}
-				}
-				currentItem = currentItem->next;
+			for (size_t j = 0; j < currentItem->fieldItems.size(); j++) {
+				if (poll)
+					currentItem->fieldItems[j]->poll();
+				else
+					currentItem->fieldItems[j]->activate();
 			}
-			myItems.unlock();
 		}
-		else {
-			for (uInt32 i = 0; i < (**PvIndexArray)->dimSize; i++) {
-				currentItem = (calabItem*)(**PvIndexArray)->elt[i];
-				if (!valid(currentItem)) {
-					DbgTime(); CaLabDbgPrintf("Error in wait4value: Index array is corrupted.");
-					continue;
-				}
-				if (isFirstRun) {
-					currentItem->isPassive = false;
-				}
-				else {
-					if (currentItem->hasValue) {
-						if (!currentItem->parent) {
-							counter++;
-							currentItem->lock();
-							if (currentItem->numberOfValues > maxNumberOfValues)
-								maxNumberOfValues = currentItem->numberOfValues;
-							currentItem->unlock();
-						}
-					}
-					else {
-						//break;
-					}
+		// callbacks count down the latch as soon as PV is resolved, polled PVs wait for a fresh value
+		if (!currentItem->parent && (poll || !currentItem->hasValue) && !currentItem->isMissing) {
+			latch->count++;
+			currentItem->latches.push_back(latch);
+		}
+		currentItem->unlock();
+	}
+	bool timedOut = !latch->wait(stop);
+	for (uInt32 i = 0; i < (**PvIndexArray)->dimSize; i++) {
+		currentItem = (calabItem*)(**PvIndexArray)->elt[i];
+		if (!valid(currentItem) || currentItem->parent) {
+			continue;
+		}
+		currentItem->lock();
+		if (timedOut) {
+			for (std::vector<valueLatchPtr>::iterator it = currentItem->latches.begin(); it != currentItem->latches.end(); ++it) {
+				if (*it == latch) {
+					currentItem->latches.erase(it);
+					break;
 				}
 			}
 		}
-		isFirstRun = false;
-		if (counter > (**PvIndexArray)->dimSize)
-			break;
-		epicsThreadSleep(.001);
+		if ((currentItem->hasValue || currentItem->isMissing) && currentItem->numberOfValues > maxNumberOfValues)
+			maxNumberOfValues = currentItem->numberOfValues;
+		currentItem->unlock();
 	}
-	if (timeout >= stop) {
+	if (timedOut) {
 		//CaLabDbgPrintfD("timeout in wait4value");
-		if (all) {
-			myItems.lock();
-			currentItem = myItems.firstItem;
-			while (currentItem) {
-				if (!valid(currentItem)) {
-					currentItem = myItems.firstItem;
-					continue;
-				}
-				if (!currentItem->hasValue) {
-					if (currentItem->parent && currentItem->parent->hasValue) {
-						currentItem->hasValue = true;
-						currentItem->isPassive = true;
-					}
-					//CaLabDbgPrintfD("%s has no value", currentItem->szName);
-				}
-				currentItem = currentItem->next;
+		for (uInt32 i = 0; i < (**PvIndexArray)->dimSize; i++) {
+			currentItem = (calabItem*)(**PvIndexArray)->elt[i];
+			if (!valid(currentItem)) {
+				continue;
 			}
-			myItems.unlock();
-		}
-		else {
-			for (uInt32 i = 0; i < (**PvIndexArray)->dimSize; i++) {
-				currentItem = (calabItem*)(**PvIndexArray)->elt[i];
-				if (!valid(currentItem)) {
-					continue;
+			if (!currentItem->hasValue) {
+				if (currentItem->parent && currentItem->parent->hasValue) {
+					currentItem->hasValue = true;
+					currentItem->deactivate();
 				}
-				if (!currentItem->hasValue) {
-					if (currentItem->parent && currentItem->parent->hasValue) {
-						currentItem->hasValue = true;
-						currentItem->isPassive = true;
+				//CaLabDbgPrintfD("%s has no value", currentItem->szName);
+			}
+			if (all && currentItem->hasValue) {
+				currentItem->lock();
+				for (size_t j = 0; j < currentItem->fieldItems.size(); j++) {
+					if (!currentItem->fieldItems[j]->hasValue) {
+						currentItem->fieldItems[j]->hasValue = true;
+						currentItem->fieldItems[j]->deactivate();
 					}
-					//CaLabDbgPrintfD("%s has no value", currentItem->szName);
 				}
+				currentItem->unlock();
 			}
 		}
 	}
 }
 
+// delivery state of one getValue caller
+// kept by the library, LV may copy, replace or reuse any of its handles between two calls
+struct deliveryState {
+	void*					outputs[DELIVERY_OUTPUTS] = {};		// output handles of last call
+	std::vector<uint64_t>	items;									// data objects of last call (PvIndexArray)
+	std::vector<uInt32>		sequences;								// updateSequence of items delivered at last call
+};
+
+// get update sequences delivered by getValue
+// state is forgotten if any output handle or data object differs from last call or if any VI was unloaded
+//    PvIndexArray: index array of getValue
+//    outputs: current output handles of getValue
+//    reset: true = forget delivered sequences; set to true if state was forgotten
+//    returns state or empty pointer if no state is available (full update)
+std::shared_ptr<deliveryState> deliveredSequences(sLongArrayHdl PvIndexArray, void* const outputs[DELIVERY_OUTPUTS], bool &reset) {
+	std::shared_ptr<deliveryState> state;
+	size_t n = (*PvIndexArray)->dimSize;
+	if (!deliveryLock)
+		return state;
+	epicsMutexLock(deliveryLock);
+	try {
+		if (deliveryEpoch != eventEpoch.load() || deliveries.size() >= MAX_DELIVERY_STATES) {
+			deliveries.clear();
+			deliveryEpoch = eventEpoch.load();
+		}
+		std::shared_ptr<deliveryState>& entry = deliveries[(void*)PvIndexArray];
+		if (!entry)
+			entry = std::make_shared<deliveryState>();
+		state = entry;
+	}
+	catch (...) {
+		state.reset();
+	}
+	epicsMutexUnlock(deliveryLock);
+	if (!state)
+		return state;
+	try {
+		if (memcmp(state->outputs, outputs, sizeof(state->outputs)) || state->items.size() != n
+			|| (n && memcmp(state->items.data(), (*PvIndexArray)->elt, n * sizeof(uint64_t)))) {
+			memcpy(state->outputs, outputs, sizeof(state->outputs));
+			state->items.assign((*PvIndexArray)->elt, (*PvIndexArray)->elt + n);
+			reset = true;
+		}
+		if (reset)
+			state->sequences.assign(n, 0);
+	}
+	catch (...) {
+		state->items.clear();
+		state.reset();
+	}
+	return state;
+}
+
 // read EPICS PVs
 //    PvNameArray:            handle of a array of PV names
 //    FieldNameArray:         handle of a array of optional field names
@@ -2067,8 +3323,13 @@ void wait4value(uInt32 &maxNumberOfValues, sLongArrayHdl* PvIndexArray, time_t T
 //    CommunicationStatus:    status of Channel Access communication; 0 = no problem; 1 = any problem occurred
 //    FirstCall:              indicator for first call
 //    NoMDEL:                 indicator for ignoring monitor dead band (TRUE: use caget instead of camonitor)
-extern "C" EXPORT void getValue(sStringArrayHdl *PvNameArray, sStringArrayHdl *FieldNameArray, sLongArrayHdl *PvIndexArray, double Timeout, sResultArrayHdl *ResultArray, sStringArrayHdl *FirstStringValue, sDoubleArrayHdl *FirstDoubleValue, sDoubleArray2DHdl *DoubleValueArray, LVBoolean *CommunicationStatus, LVBoolean *FirstCall, LVBoolean *NoMDEL = 0, LVBoolean *IsInitialized = 0) {
-	epicsMutexLock(getLock);
+//    IsInitialized:          indicator for initialized result arrays
+//    ByteValueArray:         optional handle of a 2d array of I8 values (same layout as DoubleValueArray)
+//    WordValueArray:         optional handle of a 2d array of I16 values
+//    IntValueArray:          optional handle of a 2d array of I32 values
+//    FloatValueArray:        optional handle of a 2d array of SGL values
+//    LongValueArray:         optional handle of a 2d array of I64 values (integers are not converted via double)
+extern "C" EXPORT void getValue(sStringArrayHdl *PvNameArray, sStringArrayHdl *FieldNameArray, sLongArrayHdl *PvIndexArray, double Timeout, sResultArrayHdl *ResultArray, sStringArrayHdl *FirstStringValue, sDoubleArrayHdl *FirstDoubleValue, sDoubleArray2DHdl *DoubleValueArray, LVBoolean *CommunicationStatus, LVBoolean *FirstCall, LVBoolean *NoMDEL = 0, LVBoolean *IsInitialized = 0, sByteArray2DHdl *ByteValueArray = 0, sWordArray2DHdl *WordValueArray = 0, sIntArray2DHdl *IntValueArray = 0, sFloatArray2DHdl *FloatValueArray = 0, sLongArray2DHdl *LongValueArray = 0) {
 	if (!*FirstCall && *ResultArray) {
 		//CaLabDbgPrintf("*ResultArray=%p", *ResultArray);
 		if (!(**ResultArray)->result[0].ValueNumberArray) {
@@ -2078,19 +3339,16 @@ extern "C" EXPORT void getValue(sStringArrayHdl *PvNameArray, sStringArrayHdl *F
 	}
 	try {
 		if (stopped) {
-			epicsMutexUnlock(getLock);
 			return;
 		}
 		if (!*PvNameArray || (**PvNameArray)->dimSize == 0 || !(**PvNameArray)->elt[0]) {
 			DbgTime(); CaLabDbgPrintf("Warning: caLabGet needs any PV name");
-			epicsMutexUnlock(getLock);
 			return;
 		}
 		sResult* currentResult;
 		calabItem* currentItem;
 		MgErr err = noErr;
 		uInt32 maxNumberOfValues = 0;
-		uInt32 doubleValueArrayIndex = 0;
 		*CommunicationStatus = 0;
 		if (bCaLabPolling)
 			*NoMDEL = true;
@@ -2098,10 +3356,10 @@ extern "C" EXPORT void getValue(sStringArrayHdl *PvNameArray, sStringArrayHdl *F
 			*FirstCall = true;
 			*IsInitialized = false;
 		}
-		if (allItemsConnected1 && !allItemsConnected2) {
+		int firstCallAfterConnect = 0;
+		if (allItemsConnected1 && allItemsConnected2.compare_exchange_strong(firstCallAfterConnect, 1)) {
 			*FirstCall = true;
 			*IsInitialized = false;
-			allItemsConnected2 = true;
 			//CaLabDbgPrintf("(allItemsConnected1 && !allItemsConnected2) (%d)", (**PvNameArray)->dimSize);
 		}
 		if (!*IsInitialized) {
@@ -2176,12 +3434,11 @@ extern "C" EXPORT void getValue(sStringArrayHdl *PvNameArray, sStringArrayHdl *F
 					currentItem = myItems.add((**PvNameArray)->elt[i], *FieldNameArray);
 					if (!currentItem) {
 						CaLabDbgPrintf("Error in creating PV %.*s", (*(**PvNameArray)->elt[i])->cnt, (*(**PvNameArray)->elt[i])->str);
-						epicsMutexUnlock(getLock);
 						return;
 					}
 					/*if (currentItem->isPassive)
 					CaLabDbgPrintfD("please subscribe channel for %s", currentItem->szName);*/
-					currentItem->isPassive = false;
+					currentItem->activate();
 					//currentItem->reconnect();
 					//CaLabDbgPrintfD("currentItem->caID=%d     currentItem->caEventID=%d",currentItem->caID, currentItem->caEventID);
 					(**PvIndexArray)->elt[i] = (uint64_t)currentItem;
@@ -2190,7 +3447,7 @@ extern "C" EXPORT void getValue(sStringArrayHdl *PvNameArray, sStringArrayHdl *F
 					(*(**ResultArray)->result[i].PVName)->cnt = (*currentItem->name)->cnt;
 					//CaLabDbgPrintf("New ResultArray->result[%d].PVName %p->%p->%p(%d)", i, **ResultArray, (**ResultArray)->result[i] , *(**ResultArray)->result[i].PVName, (*(**ResultArray)->result[i].PVName)->cnt);
 				}
-				wait4value(maxNumberOfValues, PvIndexArray, (time_t)Timeout, true);
+				wait4value(maxNumberOfValues, PvIndexArray, Timeout, true, NoMDEL && *NoMDEL);
 				//if(maxNumberOfValues > 0)
 				//	CaLabDbgPrintfD("maxNumberOfValues=%d", maxNumberOfValues);
 				if (!maxNumberOfValues) {
@@ -2215,7 +3472,6 @@ extern "C" EXPORT void getValue(sStringArrayHdl *PvNameArray, sStringArrayHdl *F
 							*CommunicationStatus = 1;
 						currentItem->unlock();
 					}
-					epicsMutexUnlock(getLock);
 					return;
 				}
 				if (!*FirstStringValue || (**FirstStringValue)->dimSize != (**PvNameArray)->dimSize) {
@@ -2237,14 +3493,13 @@ extern "C" EXPORT void getValue(sStringArrayHdl *PvNameArray, sStringArrayHdl *F
 			}   // END: RESET LV VARIABLES
 			else {
 				if (*NoMDEL) {
-					wait4value(maxNumberOfValues, PvIndexArray, (time_t)Timeout);
+					wait4value(maxNumberOfValues, PvIndexArray, Timeout, false, true);
 				}
 				if (*DoubleValueArray) {
 					maxNumberOfValues = (**DoubleValueArray)->dimSizes[1];
 				}
 				else {
 					*CommunicationStatus = 1;
-					epicsMutexUnlock(getLock);
 					return;
 				}
 			}
@@ -2254,16 +3509,39 @@ extern "C" EXPORT void getValue(sStringArrayHdl *PvNameArray, sStringArrayHdl *F
 				maxNumberOfValues = (**DoubleValueArray)->dimSizes[1];
 			}
 		}
+		// only PVs changed since last call are copied, unless outputs are new
+		bool fullUpdate = *FirstCall || (NoMDEL && *NoMDEL)
+			|| !hasDims(ByteValueArray, (uInt32)(**PvIndexArray)->dimSize, maxNumberOfValues)
+			|| !hasDims(WordValueArray, (uInt32)(**PvIndexArray)->dimSize, maxNumberOfValues)
+			|| !hasDims(IntValueArray, (uInt32)(**PvIndexArray)->dimSize, maxNumberOfValues)
+			|| !hasDims(FloatValueArray, (uInt32)(**PvIndexArray)->dimSize, maxNumberOfValues)
+			|| !hasDims(LongValueArray, (uInt32)(**PvIndexArray)->dimSize, maxNumberOfValues);
+		// optional arrays in native width use layout of DoubleValueArray
+		err += resizeArray2D(ByteValueArray, iB, (uInt32)(**PvIndexArray)->dimSize, maxNumberOfValues);
+		err += resizeArray2D(WordValueArray, iW, (uInt32)(**PvIndexArray)->dimSize, maxNumberOfValues);
+		err += resizeArray2D(IntValueArray, iL, (uInt32)(**PvIndexArray)->dimSize, maxNumberOfValues);
+		err += resizeArray2D(FloatValueArray, fS, (uInt32)(**PvIndexArray)->dimSize, maxNumberOfValues);
+		err += resizeArray2D(LongValueArray, iQ, (uInt32)(**PvIndexArray)->dimSize, maxNumberOfValues);
+		void* outputs[DELIVERY_OUTPUTS] = { *ResultArray, *FirstStringValue, *FirstDoubleValue, *DoubleValueArray,
+			ByteValueArray ? *ByteValueArray : 0x0, WordValueArray ? *WordValueArray : 0x0, IntValueArray ? *IntValueArray : 0x0,
+			FloatValueArray ? *FloatValueArray : 0x0, LongValueArray ? *LongValueArray : 0x0 };
+		std::shared_ptr<deliveryState> delivered = deliveredSequences(*PvIndexArray, outputs, fullUpdate);
 		//CaLabDbgPrintf("ResultArray %p(%d)", **ResultArray, (**ResultArray)->dimSize);
 		for (uInt32 i = 0; i < (**PvIndexArray)->dimSize; i++) {
 			currentItem = (calabItem*)(**PvIndexArray)->elt[i];
 			if (!valid(currentItem)) {
 				*CommunicationStatus = 1;
 				DbgTime(); CaLabDbgPrintf("Error in getValue: Index array is corrupted.");
-				epicsMutexUnlock(getLock);
 				return;
 			}
+			if (delivered && !fullUpdate && delivered->sequences[i] == currentItem->updateSequence) {
+				if ((**ResultArray)->result[i].ErrorIO.code)
+					*CommunicationStatus = 1;
+				continue;
+			}
 			currentItem->lock();
+			if (delivered)
+				delivered->sequences[i] = currentItem->updateSequence;
 			currentResult = &(**ResultArray)->result[i];
 			if (currentItem->StatusString) {
 				if (!currentResult->StatusString || (*currentResult->StatusString)->cnt != (*currentItem->StatusString)->cnt) {
@@ -2304,42 +3582,9 @@ extern "C" EXPORT void getValue(sStringArrayHdl *PvNameArray, sStringArrayHdl *F
 				currentItem->unlock();
 				continue;
 			}
-			if (!currentResult->StringValueArray || (*currentResult->StringValueArray)->dimSize != currentItem->numberOfValues) {
-				if (currentResult->StringValueArray) {
-					DeleteStringArray(currentResult->StringValueArray);
-				}
-				currentResult->StringValueArray = (sStringArrayHdl)DSNewHClr(sizeof(size_t) + currentItem->numberOfValues * sizeof(LStrHandle[1]));
-				(*currentResult->StringValueArray)->dimSize = currentItem->numberOfValues;
-				err += NumericArrayResize(fD, 1, (UHandle*)&currentResult->ValueNumberArray, currentItem->numberOfValues);
-				(*currentResult->ValueNumberArray)->dimSize = currentItem->numberOfValues;
-			}
-			for (uInt32 j = 0; maxNumberOfValues > 0 && j < (*currentResult->StringValueArray)->dimSize; j++) {
-				if (!(*currentItem->stringValueArray)->elt[j]) {
-					if (maxNumberOfValues > 0 && currentItem->numberOfValues != maxNumberOfValues)
-						doubleValueArrayIndex += maxNumberOfValues - currentItem->numberOfValues;
-					continue;
-				}
-				if (!currentResult->StringValueArray || !(*currentResult->StringValueArray)->elt[j] || (*(*currentItem->stringValueArray)->elt[j])->cnt != (*(*currentResult->StringValueArray)->elt[j])->cnt) {
-					err += NumericArrayResize(uB, 1, (UHandle*)&(*currentResult->StringValueArray)->elt[j], (*(*currentItem->stringValueArray)->elt[j])->cnt);
-					(*(*currentResult->StringValueArray)->elt[j])->cnt = (*(*currentItem->stringValueArray)->elt[j])->cnt;
-				}
-				memcpy((*(*currentResult->StringValueArray)->elt[j])->str, (*(*currentItem->stringValueArray)->elt[j])->str, (*(*currentItem->stringValueArray)->elt[j])->cnt);
-				(*currentResult->ValueNumberArray)->elt[j] = (*currentItem->doubleValueArray)->elt[j];
-				if (j == 0) {
-					err += DSCopyHandle(&(**FirstStringValue)->elt[i], (*currentResult->StringValueArray)->elt[j]);
-					(**FirstDoubleValue)->elt[i] = (*currentItem->doubleValueArray)->elt[j];
-				}
-				//if (doubleValueArrayIndex < (**DoubleValueArray)->dimSizes[0] * (**DoubleValueArray)->dimSizes[1]) {
-				(**DoubleValueArray)->elt[doubleValueArrayIndex++] = (*currentItem->doubleValueArray)->elt[j];
-				//}
-				//else {
-				//	CaLabDbgPrintf("bad index for Double[][] result");
-				//	doubleValueArrayIndex++;
-				//}
-			}
-			currentResult->valueArraySize = currentItem->numberOfValues;
-			if (maxNumberOfValues > 0 && currentItem->numberOfValues != maxNumberOfValues)
-				doubleValueArrayIndex += maxNumberOfValues - currentItem->numberOfValues;
+			// values matching time stamp, formatted and copied after unlock
+			valueSnapshotPtr values = currentItem->getValues();
+			uInt32 count = currentItem->numberOfValues;
 			if (!currentResult->FieldNameArray && FieldNameArray && *FieldNameArray) {
 				if (currentResult->FieldNameArray)
 					err += DeleteStringArray(currentResult->FieldNameArray);
@@ -2369,55 +3614,260 @@ extern "C" EXPORT void getValue(sStringArrayHdl *PvNameArray, sStringArrayHdl *F
 				}
 			}
 			currentItem->unlock();
-			if (*NoMDEL) {
-				currentItem->disconnect();
+			if (!currentResult->StringValueArray || (*currentResult->StringValueArray)->dimSize != count) {
+				if (currentResult->StringValueArray) {
+					DeleteStringArray(currentResult->StringValueArray);
+				}
+				currentResult->StringValueArray = (sStringArrayHdl)DSNewHClr(sizeof(size_t) + count * sizeof(LStrHandle[1]));
+				(*currentResult->StringValueArray)->dimSize = count;
+				err += NumericArrayResize(fD, 1, (UHandle*)&currentResult->ValueNumberArray, count);
+				(*currentResult->ValueNumberArray)->dimSize = count;
+			}
+			currentResult->valueArraySize = count;
+			// monitor callbacks are not blocked while strings are formatted and numeric arrays are copied
+			if (values) {
+				values->formatStrings();
+				for (uInt32 j = 0; maxNumberOfValues > 0 && values->strings && j < (*currentResult->StringValueArray)->dimSize && j < (*values->strings)->dimSize; j++) {
+					if (!(*values->strings)->elt[j])
+						continue;
+					if (!(*currentResult->StringValueArray)->elt[j] || (*(*values->strings)->elt[j])->cnt != (*(*currentResult->StringValueArray)->elt[j])->cnt) {
+						err += NumericArrayResize(uB, 1, (UHandle*)&(*currentResult->StringValueArray)->elt[j], (*(*values->strings)->elt[j])->cnt);
+						(*(*currentResult->StringValueArray)->elt[j])->cnt = (*(*values->strings)->elt[j])->cnt;
+					}
+					memcpy((*(*currentResult->StringValueArray)->elt[j])->str, (*(*values->strings)->elt[j])->str, (*(*values->strings)->elt[j])->cnt);
+					if (j == 0)
+						err += DSCopyHandle(&(**FirstStringValue)->elt[i], (*currentResult->StringValueArray)->elt[j]);
+				}
+				if (ByteValueArray && *ByteValueArray)
+					values->copyValues(&(**ByteValueArray)->elt[i * maxNumberOfValues], maxNumberOfValues);
+				if (WordValueArray && *WordValueArray)
+					values->copyValues(&(**WordValueArray)->elt[i * maxNumberOfValues], maxNumberOfValues);
+				if (IntValueArray && *IntValueArray)
+					values->copyValues(&(**IntValueArray)->elt[i * maxNumberOfValues], maxNumberOfValues);
+				if (FloatValueArray && *FloatValueArray)
+					values->copyValues(&(**FloatValueArray)->elt[i * maxNumberOfValues], maxNumberOfValues);
+				if (LongValueArray && *LongValueArray)
+					values->copyValues(&(**LongValueArray)->elt[i * maxNumberOfValues], maxNumberOfValues);
+				if (*DoubleValueArray && i < (**DoubleValueArray)->dimSizes[0])
+					values->copyValues(&(**DoubleValueArray)->elt[i * maxNumberOfValues], maxNumberOfValues);
+				if (maxNumberOfValues > 0 && currentResult->ValueNumberArray) {
+					values->copyValues((*currentResult->ValueNumberArray)->elt, (uInt32)(*currentResult->ValueNumberArray)->dimSize);
+					if ((*currentResult->ValueNumberArray)->dimSize > 0)
+						(**FirstDoubleValue)->elt[i] = (*currentResult->ValueNumberArray)->elt[0];
+				}
 			}
 		}
 	}
 	catch (...) {
 		CaLabDbgPrintfD("exception in getValue");
 	}
-	epicsMutexUnlock(getLock);
 }
 
-// creates new LV user event
+// creates new LV user event with selected payload
+// without PAYLOAD_STRINGS no strings are formatted or copied for this event
 //    RefNum:            reference number of event
-//    ResultArrayHdl:    target item
-extern "C" EXPORT void addEvent(LVUserEventRef *RefNum, sResult *ResultPtr) {
+//    ResultPtr:         target item
+//    PayloadProfile:    members of ResultPtr written by events (PAYLOAD_*)
+//    MaxRate:           maximum number of events per second (<= 0: unlimited)
+//    MinInterval:       minimum seconds between events (<= 0: unlimited)
+//    QueueLength:       events posted back to back before limit applies (0, 1: latest only)
+extern "C" EXPORT void addEventEx(LVUserEventRef *RefNum, sResult *ResultPtr, uInt32 PayloadProfile, double MaxRate = 0, double MinInterval = 0, uInt32 QueueLength = 0) {
 	// Don't enter if library terminates
 	if (stopped)
 		return;
-	if (!ResultPtr
-		|| DSCheckPtr(ResultPtr) != noErr
-		|| !ResultPtr->PVName
-		|| DSCheckHandle(ResultPtr->PVName) != noErr
-		|| !ResultPtr->ValueNumberArray
-		|| DSCheckHandle(ResultPtr->ValueNumberArray) != noErr
-		|| !ResultPtr->StringValueArray
-		|| DSCheckHandle(ResultPtr->StringValueArray) != noErr
-		|| !ResultPtr->StatusString
-		|| DSCheckHandle(ResultPtr->StatusString) != noErr
-		|| !ResultPtr->SeverityString
-		|| DSCheckHandle(ResultPtr->SeverityString) != noErr
-		|| !ResultPtr->TimeStampString
-		|| DSCheckHandle(ResultPtr->TimeStampString) != noErr
-		|| !ResultPtr->ErrorIO.source
-		|| DSCheckHandle(ResultPtr->ErrorIO.source) != noErr
-		|| (ResultPtr->FieldNameArray && DSCheckHandle(ResultPtr->FieldNameArray) != noErr)
-		|| (ResultPtr->FieldValueArray && DSCheckHandle(ResultPtr->FieldValueArray) != noErr)) {
-		return;
-	}
-	if (!ResultPtr || !ResultPtr->PVName)
+	uInt32 currentEpoch = eventEpoch.load();
+	if (!validResult(ResultPtr))
 		return;
+	eventLimit limit;
+	if (MaxRate > 0)
+		limit.interval = 1 / MaxRate;
+	if (MinInterval > limit.interval)
+		limit.interval = MinInterval;
+	limit.capacity = QueueLength > 1 ? QueueLength : 1;
+	limit.tokens = limit.capacity;
+	limit.refilled = std::chrono::steady_clock::now();
 	calabItem* currentItem = 0x0;
 	currentItem = myItems.add(ResultPtr->PVName, 0x0);
 	currentItem->lock();
-	currentItem->RefNum.push_back(*RefNum);
-	currentItem->eventResultCluster.push_back(ResultPtr);
+	eventSubscriber subscriber;
+	subscriber.RefNum = *RefNum;
+	subscriber.cluster = ResultPtr;
+	subscriber.epoch = currentEpoch;
+	subscriber.profile = PayloadProfile & PAYLOAD_STRINGS ? PAYLOAD_FULL : PayloadProfile;
+	subscriber.limit = limit;
+	currentItem->eventSubscribers.push_back(subscriber);
 	currentItem->unlock();
 	currentItem->postEvent();
 }
 
+// creates new LV user event
+//    RefNum:            reference number of event
+//    ResultArrayHdl:    target item
+extern "C" EXPORT void addEvent(LVUserEventRef *RefNum, sResult *ResultPtr) {
+	addEventEx(RefNum, ResultPtr, PAYLOAD_FULL, 0, 0, 0);
+}
+
+// subscriber of batched user events
+// gets one event per period with all of its PVs changed in that period
+struct batchSubscriber {
+	LVUserEventRef			RefNum;									// LV user event (array of sBatchEntry)
+	std::vector<calabItem*>	items;									// data objects in order of PvNameArray
+	std::vector<uInt32>		sequences;								// updateSequence of items at last event
+	std::chrono::steady_clock::duration period;						// minimum time between events
+	std::chrono::steady_clock::time_point due;						// time of next event
+	sBatchArrayHdl			batch = 0x0;							// event data, reused for every event
+
+	~batchSubscriber() {
+		if (batch) {
+			for (size_t i = 0; i < (*batch)->dimSize; i++) {
+				if ((*batch)->elt[i].ValueNumberArray)
+					DSDisposeHandle((*batch)->elt[i].ValueNumberArray);
+			}
+			DSDisposeHandle(batch);
+		}
+	}
+
+	// post changed PVs as one user event
+	//    returns false if event could not be posted (subscriber is removed)
+	bool post() {
+		uInt32 changedCount = 0;
+		uInt32 sequence;
+		for (size_t i = 0; i < items.size(); i++) {
+			if (items[i]->hasValue && items[i]->updateSequence.load() != sequences[i])
+				changedCount++;
+		}
+		if (!changedCount)
+			return true;
+		size_t oldSize = batch ? (*batch)->dimSize : 0;
+		if (!batch || oldSize < changedCount) {
+			sBatchArrayHdl tmp = (sBatchArrayHdl)DSNewHClr(sizeof(size_t) + changedCount * sizeof(sBatchEntry));
+			if (!tmp)
+				return true;
+			if (batch) {
+				memcpy((*tmp)->elt, (*batch)->elt, oldSize * sizeof(sBatchEntry));
+				DSDisposeHandle(batch);
+			}
+			batch = tmp;
+		}
+		else {
+			// release value handles of unused entries
+			for (size_t i = changedCount; i < oldSize; i++) {
+				if ((*batch)->elt[i].ValueNumberArray)
+					DSDisposeHandle((*batch)->elt[i].ValueNumberArray);
+				(*batch)->elt[i].ValueNumberArray = 0x0;
+			}
+		}
+		(*batch)->dimSize = changedCount;
+		uInt32 entry = 0;
+		valueSnapshotPtr values;
+		for (size_t i = 0; i < items.size() && entry < changedCount; i++) {
+			calabItem* item = items[i];
+			sequence = item->updateSequence.load();
+			if (!item->hasValue || sequence == sequences[i])
+				continue;
+			sBatchEntry* current = &(*batch)->elt[entry];
+			current->Index = (uInt32)i;
+			item->lock();
+			current->StatusNumber = item->StatusNumber;
+			current->SeverityNumber = item->SeverityNumber;
+			current->TimeStampNumber = item->TimeStampNumber;
+			current->ErrorCode = item->ErrorIO.code;
+			item->unlock();
+			values = item->getValues();
+			uInt32 count = values ? values->valueCount : 0;
+			if (!current->ValueNumberArray || (*current->ValueNumberArray)->dimSize != count) {
+				// PV stays changed and is part of the next event
+				if (NumericArrayResize(fD, 1, (UHandle*)&current->ValueNumberArray, count) != noErr || !current->ValueNumberArray)
+					continue;
+				(*current->ValueNumberArray)->dimSize = count;
+			}
+			if (values)
+				values->copyValues((*current->ValueNumberArray)->elt, count);
+			sequences[i] = sequence;
+			entry++;
+		}
+		for (size_t i = entry; i < changedCount; i++) {
+			if ((*batch)->elt[i].ValueNumberArray)
+				DSDisposeHandle((*batch)->elt[i].ValueNumberArray);
+			(*batch)->elt[i].ValueNumberArray = 0x0;
+		}
+		(*batch)->dimSize = entry;
+		return PostLVUserEvent(RefNum, &batch) == mgNoErr;
+	}
+};
+
+// add LV user event for a set of PVs
+// the event (array of sBatchEntry) carries all PVs changed since the previous event
+//    RefNum:          LV user event
+//    PvNameArray:     PV names, Index of sBatchEntry refers to this array
+//    MaxRate:         maximum number of events per second (<= 0: BATCH_EVENT_RATE)
+extern "C" EXPORT void addBatchEvent(LVUserEventRef *RefNum, sStringArrayHdl *PvNameArray, double MaxRate) {
+	// Don't enter if library terminates
+	if (stopped || !RefNum || !*RefNum || !PvNameArray || !*PvNameArray || !batchLock)
+		return;
+	try {
+		// subscriber is owned here until it is queued
+		std::unique_ptr<batchSubscriber> subscriber(new batchSubscriber());
+		calabItem* currentItem;
+		subscriber->RefNum = *RefNum;
+		if (MaxRate <= 0)
+			MaxRate = BATCH_EVENT_RATE;
+		subscriber->period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1 / MaxRate));
+		subscriber->due = std::chrono::steady_clock::now();
+		for (uInt32 i = 0; i < (**PvNameArray)->dimSize; i++) {
+			currentItem = myItems.add((**PvNameArray)->elt[i], 0x0);
+			if (!currentItem) {
+				CaLabDbgPrintf("Error in creating PV %.*s", (*(**PvNameArray)->elt[i])->cnt, (*(**PvNameArray)->elt[i])->str);
+				return;
+			}
+			currentItem->activate();
+			subscriber->items.push_back(currentItem);
+			subscriber->sequences.push_back(0);
+		}
+		epicsMutexLock(batchLock);
+		batchSubscribers.push_back(subscriber.get());
+		subscriber.release();
+		epicsMutexUnlock(batchLock);
+		epicsEventSignal(dispatchEvent);
+	}
+	catch (...) {
+		CaLabDbgPrintfD("exception in addBatchEvent");
+	}
+}
+
+// remove subscribers of batched user events
+//    RefNum:          LV user event of subscribers to remove
+//    All:             ignore RefNum and remove all subscribers
+void removeBatchEvents(LVUserEventRef RefNum, bool All) {
+	if (!batchLock)
+		return;
+	epicsMutexLock(batchLock);
+	std::vector<batchSubscriber*>::iterator it = batchSubscribers.begin();
+	while (it != batchSubscribers.end()) {
+		if (All || (*it)->RefNum == RefNum) {
+			delete *it;
+			it = batchSubscribers.erase(it);
+			continue;
+		}
+		++it;
+	}
+	epicsMutexUnlock(batchLock);
+}
+
+// remove LV user event for a set of PVs
+//    RefNum:          LV user event given to addBatchEvent
+extern "C" EXPORT void removeBatchEvent(LVUserEventRef *RefNum) {
+	// Don't enter if library terminates
+	if (stopped || !RefNum || !*RefNum)
+		return;
+	try {
+		removeBatchEvents(*RefNum, false);
+	}
+	catch (...) {
+		CaLabDbgPrintfD("exception in removeBatchEvent");
+	}
+}
+
 // Write EPICS PV
 //    PvNameArray:        array of PV names
 //    PvIndexArray:       handle of a array of indexes
@@ -2431,6 +3881,11 @@ extern "C" EXPORT void addEvent(LVUserEventRef *RefNum, sResult *ResultPtr) {
 //    ErrorArray:         array of resulting errors
 //    Status:             0 = no problem; 1 = any problem occurred
 //    FirstCall:          indicator for first call
+//    Asynchronous:       true = values are converted and queued for caPutTask, call returns at once
+//                        ErrorArray reports queueing only (ECA_PUTFAIL if queue is full)
+//                        with CALAB_COALESCE_PUTS a still queued put of the same PV takes the newer values
+//                        if both puts report their completion to the same PutEventRef (or none)
+//    PutEventRef:        optional LV user event (sPutResult) for completion or failure of each asynchronous put
 //    dataTypes
 //   ===========
 //        # => LabVIEW                          => C++       => EPICS
@@ -2440,8 +3895,8 @@ extern "C" EXPORT void addEvent(LVUserEventRef *RefNum, sResult *ResultPtr) {
 //        3 => Byte signed integer              => char      => dbr_char_t
 //        4 => Word signed integer              => short     => dbr_short_t
 //        5 => Long signed integer              => long      => dbr_long_t
-//        6 => Quad signed integer              => long      => dbr_long_t
-extern "C" EXPORT void putValue(sStringArrayHdl *PvNameArray, sLongArrayHdl *PvIndexArray, sStringArray2DHdl *StringValueArray2D, sDoubleArray2DHdl *DoubleValueArray2D, sLongArray2DHdl *LongValueArray2D, uInt32 DataType, double Timeout, LVBoolean *Synchronous, sErrorArrayHdl *ErrorArray, LVBoolean *Status, LVBoolean *FirstCall) {
+//        6 => Quad signed integer              => long      => dbr_long_t (dbr_double_t for DBF_DOUBLE or values beyond 32 bits)
+extern "C" EXPORT void putValue(sStringArrayHdl *PvNameArray, sLongArrayHdl *PvIndexArray, sStringArray2DHdl *StringValueArray2D, sDoubleArray2DHdl *DoubleValueArray2D, sLongArray2DHdl *LongValueArray2D, uInt32 DataType, double Timeout, LVBoolean *Synchronous, sErrorArrayHdl *ErrorArray, LVBoolean *Status, LVBoolean *FirstCall, LVBoolean *Asynchronous = 0, LVUserEventRef *PutEventRef = 0) {
 	try {
 		// Don't enter if library terminates
 		if (stopped)
@@ -2539,58 +3994,132 @@ extern "C" EXPORT void putValue(sStringArrayHdl *PvNameArray, sLongArrayHdl *PvI
 			for (uInt32 i = 0; i < iNumberOfValueSets && i < (**PvNameArray)->dimSize; i++) {
 				currentItem = myItems.add((**PvNameArray)->elt[i], 0x0);
 				(**PvIndexArray)->elt[i] = (uint64_t)currentItem;
-				currentItem->isPassive = false;
+				currentItem->activate();
 			}
-			wait4value(maxNumberOfValues, PvIndexArray, (time_t)Timeout);
+			wait4value(maxNumberOfValues, PvIndexArray, Timeout);
 		}
-		for (uInt32 row = 0; row < iNumberOfValueSets && row < (**PvNameArray)->dimSize; row++) {
-			currentItem = (calabItem*)(**PvIndexArray)->elt[row];
-			if (!valid(currentItem)) {
+		uInt32 rows = iNumberOfValueSets < (**PvNameArray)->dimSize ? iNumberOfValueSets : (uInt32)(**PvNameArray)->dimSize;
+		for (uInt32 row = 0; row < rows; row++) {
+			if (!valid((calabItem*)(**PvIndexArray)->elt[row])) {
 				*Status = 1;
 				DbgTime(); CaLabDbgPrintf("Error in putValue: Index array is corrupted.");
 				return;
 			}
+		}
+		if (Asynchronous && *Asynchronous && putQueue) {
+			void* ValueArray2D = DataType == 0 ? (void*)StringValueArray2D : (DataType <= 2 ? (void*)DoubleValueArray2D : (void*)LongValueArray2D);
+			asyncPut* job;
+			for (uInt32 row = 0; row < rows; row++) {
+				currentItem = (calabItem*)(**PvIndexArray)->elt[row];
+				if (!currentItem->caID || !*(((bool*)currentItem->caID) + currentlyConnectedPos) || !currentItem->numberOfValues) {
+					currentItem->putError(&(**ErrorArray)->result[row], ECA_DISCONN);
+					continue;
+				}
+				job = getPut();
+				job->item = currentItem;
+				job->type = currentItem->convertPut(ValueArray2D, DataType, row, iValuesPerSet, job->buffer, job->bufferSize, job->count);
+				if (PutEventRef) {
+					job->RefNum = *PutEventRef;
+					job->notify = true;
+				}
+				if (job->type == TYPENOTCONN) {
+					releasePut(job);
+					currentItem->putError(&(**ErrorArray)->result[row], ECA_PUTFAIL);
+					continue;
+				}
+				currentItem->lock();
+				// last writer wins: queued put of this PV takes the newer values
+				// puts with another completion event are queued, each LV user event gets its completion
+				if (bCoalescePuts && currentItem->pendingPut && currentItem->pendingPut->notify == job->notify
+					&& (!job->notify || currentItem->pendingPut->RefNum == job->RefNum)) {
+					std::swap(currentItem->pendingPut->type, job->type);
+					std::swap(currentItem->pendingPut->count, job->count);
+					std::swap(currentItem->pendingPut->buffer, job->buffer);
+					std::swap(currentItem->pendingPut->bufferSize, job->bufferSize);
+					currentItem->putsCoalesced.fetch_add(1, std::memory_order_relaxed);
+					currentItem->unlock();
+					releasePut(job);
+				}
+				else {
+					if (bCoalescePuts)
+						currentItem->pendingPut = job;
+					if (!putQueue->push(job)) {
+						if (currentItem->pendingPut == job)
+							currentItem->pendingPut = 0x0;
+						currentItem->unlock();
+						putDropped.fetch_add(1);
+						releasePut(job);
+						currentItem->putError(&(**ErrorArray)->result[row], ECA_PUTFAIL);
+						continue;
+					}
+					currentItem->unlock();
+				}
+				currentItem->putError(&(**ErrorArray)->result[row], ECA_NORMAL);
+			}
+			epicsEventSignal(putEvent);
+			for (uInt32 row = 0; row < iNumberOfValueSets && row < (**PvNameArray)->dimSize; row++) {
+				if ((**ErrorArray)->result[row].code)
+					*Status = 1;
+			}
+			return;
+		}
+		// put group: all puts are queued and flushed at once, last put callback wakes this call
+		// latch of previous put group of this thread is reused unless late put callbacks still hold it
+		static thread_local valueLatchPtr putGroup;
+		valueLatchPtr latch;
+		if (*Synchronous) {
+			if (!putGroup || putGroup.use_count() > 1)
+				putGroup = std::make_shared<valueLatch>();
+			latch = putGroup;
+			latch->count = rows;
+			latch->status.assign(rows, ECA_NORMAL);
+		}
+		std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now() + std::chrono::milliseconds((int64_t)(Timeout * 1e3));
+		for (uInt32 row = 0; row < rows; row++) {
+			currentItem = (calabItem*)(**PvIndexArray)->elt[row];
 			switch (DataType) {
 			case 0:
-				currentItem->put((void*)StringValueArray2D, DataType, row, iValuesPerSet, &(**ErrorArray)->result[row], Timeout, *Synchronous);
+				currentItem->put((void*)StringValueArray2D, DataType, row, iValuesPerSet, &(**ErrorArray)->result[row], Timeout, *Synchronous, latch);
 				break;
 			case 1:
 			case 2:
-				currentItem->put((void*)DoubleValueArray2D, DataType, row, iValuesPerSet, &(**ErrorArray)->result[row], Timeout, *Synchronous);
+				currentItem->put((void*)DoubleValueArray2D, DataType, row, iValuesPerSet, &(**ErrorArray)->result[row], Timeout, *Synchronous, latch);
 				break;
 			case 3:
 			case 4:
 			case 5:
 			case 6:
-				currentItem->put((void*)LongValueArray2D, DataType, row, iValuesPerSet, &(**ErrorArray)->result[row], Timeout, *Synchronous);
+				currentItem->put((void*)LongValueArray2D, DataType, row, iValuesPerSet, &(**ErrorArray)->result[row], Timeout, *Synchronous, latch);
 				break;
 			default:
 				// Handled in previous switch-case statement
 				break;
 			}
 		}
-		if (*Synchronous) {
-			time_t stop = time(nullptr) + (time_t)Timeout;
-			uInt32 row;
-			double wait = (**PvNameArray)->dimSize * .00005F;
-			do {
-				epicsThreadSleep(wait);
-				for (row = 0; row < iNumberOfValueSets && row < (**PvNameArray)->dimSize; row++) {
-					currentItem = (calabItem*)(**PvIndexArray)->elt[row];
-					if (!valid(currentItem)) {
-						*Status = 1;
-						DbgTime(); CaLabDbgPrintf("Error in putValue->sync: Index array is corrupted.");
-						return;
-					}
-					if (!currentItem->putReadBack) {
-						//CaLabDbgPrintfD("%d (%F)", row, wait);
-						break;
-					}
-				}
-			} while (row < iNumberOfValueSets && row < (**PvNameArray)->dimSize && time(nullptr) < stop);
-			if (time(nullptr) > stop) {
+		requestFlush();
+		if (latch) {
+			if (!latch->wait(stop)) {
 				DbgTime(); CaLabDbgPrintfD("Write values run into timeout.");
 			}
+			// completion status of each put (LV memory is written by caller thread only)
+			for (uInt32 row = 0; row < rows; row++) {
+				if ((**ErrorArray)->result[row].code)
+					continue;
+				currentItem = (calabItem*)(**PvIndexArray)->elt[row];
+				currentItem->lock();
+				std::vector<putSlot>::iterator it = currentItem->putSlots.begin() + currentItem->putSlotsHead;
+				while (it != currentItem->putSlots.end() && (it->latch != latch || it->row != row))
+					++it;
+				if (it != currentItem->putSlots.end()) {
+					// keep slot, late callback of this put still pops it
+					it->latch.reset();
+					currentItem->putError(&(**ErrorArray)->result[row], ECA_TIMEOUT);
+				}
+				else if (latch->status[row] != ECA_NORMAL) {
+					currentItem->putError(&(**ErrorArray)->result[row], latch->status[row]);
+				}
+				currentItem->unlock();
+			}
 		}
 		for (uInt32 row = 0; row < iNumberOfValueSets && row < (**PvNameArray)->dimSize; row++) {
 			if ((**ErrorArray)->result[row].code)
@@ -2606,7 +4135,8 @@ extern "C" EXPORT void putValue(sStringArrayHdl *PvNameArray, sLongArrayHdl *PvI
 //   InfoStringArray2D:     container for results
 //   InfoStringArraySize:   elements in result container
 //   FirstCall:             indicator for first call
-extern "C" EXPORT void info(sStringArray2DHdl *InfoStringArray2D, sResultArrayHdl *ResultArray, LVBoolean *FirstCall) {
+//   PvStatisticsArray2D:   optional statistics per PV (rows like ResultArray, columns STAT_*)
+extern "C" EXPORT void info(sStringArray2DHdl *InfoStringArray2D, sResultArrayHdl *ResultArray, LVBoolean *FirstCall, sDoubleArray2DHdl *PvStatisticsArray2D = 0) {
 	try {
 		// Don't enter if library terminates
 		if (stopped)
@@ -2626,7 +4156,7 @@ extern "C" EXPORT void info(sStringArray2DHdl *InfoStringArray2D, sResultArrayHd
 			lStringArraySets++;
 			ppParam++;
 		}
-		lStringArraySets += 3; // version of library + CALAB_POLLING + CALAB_NODBG
+		lStringArraySets += 8; // version of library + CALAB_POLLING + CALAB_NODBG + CALAB_BATCH_SIZE + CALAB_MAX_RECONNECT_DELAY + connection progress + put queue + CALAB_COALESCE_PUTS
 		pszNames = (char**)malloc(lStringArraySets * sizeof(char*));
 		for (uInt32 i = 0; i < lStringArraySets; i++) {
 			pszNames[i] = (char*)malloc(255 * sizeof(char));
@@ -2676,6 +4206,24 @@ extern "C" EXPORT void info(sStringArray2DHdl *InfoStringArray2D, sResultArrayHd
 		else
 			memcpy(pszValues[count], "undefined", strlen("undefined"));
 		count++;
+		memcpy(pszNames[count], "CALAB_BATCH_SIZE", strlen("CALAB_BATCH_SIZE"));
+		epicsSnprintf(pszValues[count], 255, "%u", batchSize);
+		count++;
+		memcpy(pszNames[count], "CALAB_MAX_RECONNECT_DELAY", strlen("CALAB_MAX_RECONNECT_DELAY"));
+		epicsSnprintf(pszValues[count], 255, "%u", maxReconnectDelay);
+		count++;
+		memcpy(pszNames[count], "connected PVs", strlen("connected PVs"));
+		epicsSnprintf(pszValues[count], 255, "%u of %u (%u pending)", progressConnected.load(), progressTotal.load(), progressPending.load());
+		count++;
+		memcpy(pszNames[count], "CALAB_PUT_QUEUE_SIZE", strlen("CALAB_PUT_QUEUE_SIZE"));
+		epicsSnprintf(pszValues[count], 255, "%u queued of %u (%u dropped)", putQueue ? (uInt32)putQueue->size() : 0, putQueue ? (uInt32)putQueue->capacity() : putQueueSize, putDropped.load());
+		count++;
+		memcpy(pszNames[count], "CALAB_COALESCE_PUTS", strlen("CALAB_COALESCE_PUTS"));
+		if (getenv("CALAB_COALESCE_PUTS"))
+			memcpy(pszValues[count], getenv("CALAB_COALESCE_PUTS"), strlen(getenv("CALAB_COALESCE_PUTS")));
+		else
+			memcpy(pszValues[count], "undefined", strlen("undefined"));
+		count++;
 		// Create InfoStringArray2D or use previous one
 		err += NumericArrayResize(uQ, infoArrayDimensions, (UHandle*)InfoStringArray2D, infoArrayDimensions*lStringArraySets);
 		(**InfoStringArray2D)->dimSizes[0] = lStringArraySets;
@@ -2747,6 +4295,13 @@ extern "C" EXPORT void info(sStringArray2DHdl *InfoStringArray2D, sResultArrayHd
 		}
 		*ResultArray = (sResultArrayHdl)DSNewHClr(sizeof(size_t) + iCount * sizeof(sResult[1]));
 		(**ResultArray)->dimSize = iCount;
+		if (PvStatisticsArray2D) {
+			err += NumericArrayResize(fD, 2, (UHandle*)PvStatisticsArray2D, iCount * STAT_COLUMNS);
+			(**PvStatisticsArray2D)->dimSizes[0] = iCount;
+			(**PvStatisticsArray2D)->dimSizes[1] = STAT_COLUMNS;
+		}
+		valueSnapshotPtr values;
+		uInt32 valueCount;
 		currentItem = myItems.firstItem;
 		iCount = 0;
 		while (currentItem) {
@@ -2761,6 +4316,26 @@ extern "C" EXPORT void info(sStringArray2DHdl *InfoStringArray2D, sResultArrayHd
 				continue;
 			}
 			currentResult = &(**ResultArray)->result[iCount];
+			if (PvStatisticsArray2D) {
+				(**PvStatisticsArray2D)->elt[iCount * STAT_COLUMNS + STAT_RETRIES] = currentItem->retryCount;
+				(**PvStatisticsArray2D)->elt[iCount * STAT_COLUMNS + STAT_MISSING] = currentItem->isMissing ? 1 : 0;
+				(**PvStatisticsArray2D)->elt[iCount * STAT_COLUMNS + STAT_PUTS_SENT] = currentItem->putsSent.load(std::memory_order_relaxed);
+				(**PvStatisticsArray2D)->elt[iCount * STAT_COLUMNS + STAT_PUTS_COALESCED] = currentItem->putsCoalesced.load(std::memory_order_relaxed);
+				(**PvStatisticsArray2D)->elt[iCount * STAT_COLUMNS + STAT_EVENTS_POSTED] = currentItem->eventsPosted.load(std::memory_order_relaxed);
+				(**PvStatisticsArray2D)->elt[iCount * STAT_COLUMNS + STAT_EVENTS_COALESCED] = currentItem->eventsCoalesced.load(std::memory_order_relaxed);
+				(**PvStatisticsArray2D)->elt[iCount * STAT_COLUMNS + STAT_EVENTS_DROPPED] = currentItem->eventsDropped.load(std::memory_order_relaxed);
+				(**PvStatisticsArray2D)->elt[iCount * STAT_COLUMNS + STAT_UPDATES] = currentItem->updates.load(std::memory_order_relaxed);
+				(**PvStatisticsArray2D)->elt[iCount * STAT_COLUMNS + STAT_BYTES] = (double)currentItem->bytesReceived.load(std::memory_order_relaxed);
+				(**PvStatisticsArray2D)->elt[iCount * STAT_COLUMNS + STAT_CALLBACK_LAST] = currentItem->callbackLast.load(std::memory_order_relaxed);
+				(**PvStatisticsArray2D)->elt[iCount * STAT_COLUMNS + STAT_CALLBACK_MAX] = currentItem->callbackMax.load(std::memory_order_relaxed);
+				(**PvStatisticsArray2D)->elt[iCount * STAT_COLUMNS + STAT_INTERVAL_MEAN] = currentItem->intervalMean.load(std::memory_order_relaxed);
+				(**PvStatisticsArray2D)->elt[iCount * STAT_COLUMNS + STAT_INTERVAL_JITTER] = currentItem->intervalJitter.load(std::memory_order_relaxed);
+				(**PvStatisticsArray2D)->elt[iCount * STAT_COLUMNS + STAT_CONNECTS] = currentItem->connects.load(std::memory_order_relaxed);
+				(**PvStatisticsArray2D)->elt[iCount * STAT_COLUMNS + STAT_DISCONNECTS] = currentItem->disconnects.load(std::memory_order_relaxed);
+				(**PvStatisticsArray2D)->elt[iCount * STAT_COLUMNS + STAT_FIRST_VALUE] = currentItem->firstValueDelay.load(std::memory_order_relaxed);
+				(**PvStatisticsArray2D)->elt[iCount * STAT_COLUMNS + STAT_PUT_LATENCY_LAST] = currentItem->putLatencyLast.load(std::memory_order_relaxed);
+				(**PvStatisticsArray2D)->elt[iCount * STAT_COLUMNS + STAT_PUT_LATENCY_MAX] = currentItem->putLatencyMax.load(std::memory_order_relaxed);
+			}
 			if (currentItem->name) {
 				if (!currentResult->PVName || (*currentResult->PVName)->cnt != (*currentItem->name)->cnt) {
 					NumericArrayResize(uB, 1, (UHandle*)&currentResult->PVName, (*currentItem->name)->cnt);
@@ -2807,21 +4382,9 @@ extern "C" EXPORT void info(sStringArray2DHdl *InfoStringArray2D, sResultArrayHd
 				currentItem = currentItem->next;
 				continue;
 			}
-			if (!currentResult->StringValueArray) {
-				currentResult->StringValueArray = (sStringArrayHdl)DSNewHClr(sizeof(size_t) + currentItem->numberOfValues * sizeof(LStrHandle[1]));
-				(*currentResult->StringValueArray)->dimSize = currentItem->numberOfValues;
-				err += NumericArrayResize(fD, 1, (UHandle*)&currentResult->ValueNumberArray, currentItem->numberOfValues);
-				(*currentResult->ValueNumberArray)->dimSize = currentItem->numberOfValues;
-			}
-			for (uInt32 j = 0; j < currentItem->numberOfValues && currentItem->stringValueArray && j < (*currentItem->stringValueArray)->dimSize; j++) {
-				if (!currentResult->StringValueArray || !(*currentResult->StringValueArray)->elt[j] || (*(*currentItem->stringValueArray)->elt[j])->cnt != (*(*currentResult->StringValueArray)->elt[j])->cnt) {
-					err += NumericArrayResize(uB, 1, (UHandle*)&(*currentResult->StringValueArray)->elt[j], (*(*currentItem->stringValueArray)->elt[j])->cnt);
-					(*(*currentResult->StringValueArray)->elt[j])->cnt = (*(*currentItem->stringValueArray)->elt[j])->cnt;
-				}
-				memcpy((*(*currentResult->StringValueArray)->elt[j])->str, (*(*currentItem->stringValueArray)->elt[j])->str, (*(*currentItem->stringValueArray)->elt[j])->cnt);
-				(*currentResult->ValueNumberArray)->elt[j] = (*currentItem->doubleValueArray)->elt[j];
-				currentResult->valueArraySize = currentItem->numberOfValues;
-			}
+			// values are formatted and copied after unlock
+			values = currentItem->getValues();
+			valueCount = currentItem->numberOfValues;
 			if (!currentResult->FieldNameArray && currentItem->FieldNameArray && *currentItem->FieldNameArray) {
 				if (currentResult->FieldNameArray)
 					err += DeleteStringArray(currentResult->FieldNameArray);
@@ -2847,6 +4410,27 @@ extern "C" EXPORT void info(sStringArray2DHdl *InfoStringArray2D, sResultArrayHd
 				}
 			}
 			currentItem->unlock();
+			if (!currentResult->StringValueArray) {
+				currentResult->StringValueArray = (sStringArrayHdl)DSNewHClr(sizeof(size_t) + valueCount * sizeof(LStrHandle[1]));
+				(*currentResult->StringValueArray)->dimSize = valueCount;
+				err += NumericArrayResize(fD, 1, (UHandle*)&currentResult->ValueNumberArray, valueCount);
+				(*currentResult->ValueNumberArray)->dimSize = valueCount;
+			}
+			if (values)
+				values->formatStrings();
+			for (uInt32 j = 0; values && values->strings && j < valueCount && j < (*values->strings)->dimSize && j < (*currentResult->StringValueArray)->dimSize; j++) {
+				if (!(*values->strings)->elt[j])
+					continue;
+				if (!(*currentResult->StringValueArray)->elt[j] || (*(*values->strings)->elt[j])->cnt != (*(*currentResult->StringValueArray)->elt[j])->cnt) {
+					err += NumericArrayResize(uB, 1, (UHandle*)&(*currentResult->StringValueArray)->elt[j], (*(*values->strings)->elt[j])->cnt);
+					(*(*currentResult->StringValueArray)->elt[j])->cnt = (*(*values->strings)->elt[j])->cnt;
+				}
+				memcpy((*(*currentResult->StringValueArray)->elt[j])->str, (*(*values->strings)->elt[j])->str, (*(*values->strings)->elt[j])->cnt);
+				currentResult->valueArraySize = valueCount;
+			}
+			if (values && currentResult->ValueNumberArray)
+				values->copyValues((*currentResult->ValueNumberArray)->elt, (uInt32)(*currentResult->ValueNumberArray)->dimSize);
+			values.reset();
 			iCount++;
 			currentItem = currentItem->next;
 		}
@@ -2891,49 +4475,278 @@ extern "C" EXPORT void disconnectPVs(sStringArrayHdl *PvNameArray, bool All) {
 				currentItem = currentItem->next;
 			}
 			myItems.unlock();
+			removeBatchEvents(0, true);
 			//CaLabDbgPrintf("all items disconnected");
 			return;
 		}
 		if (*PvNameArray && **PvNameArray && ((uInt32)(**PvNameArray)->dimSize) > 0) {
 			myItems.lock();
 			for (uInt32 i = 0; i < (**PvNameArray)->dimSize; i++) {
-				currentItem = myItems.firstItem;
-				while (currentItem) {
-					if (!valid(currentItem)) {
-						CaLabDbgPrintf("Error in disconnect: Index array is corrupted.");
-						break;
+				if (!(**PvNameArray)->elt[i])
+					continue;
+				currentItem = myItems.find((*(**PvNameArray)->elt[i])->str, (*(**PvNameArray)->elt[i])->cnt);
+				if (!currentItem)
+					continue;
+				// disconnect value listeners
+				currentItem->disconnect();
+				//CaLabDbgPrintfD("%s disconnected", currentItem->szName);
+				// disconnect field listeners
+				currentItem->lock();
+				for (size_t j = 0; j < currentItem->fieldItems.size(); j++)
+					currentItem->fieldItems[j]->disconnect();
+				currentItem->unlock();
+			}
+			myItems.unlock();
+		}
+	}
+	catch (...) {
+		CaLabDbgPrintfD("exception in disconnectPVs");
+	}
+}
+
+// hand over subscription and / or channel to caTeardownTask
+//    eventID: subscription to be cleared (0x0 = none)
+//    channelID: channel to be cleared (0x0 = none)
+void postTeardown(evid eventID, chanId channelID) {
+	epicsMutexLock(teardownLock);
+	if (eventID)
+		teardownEvents.push_back(eventID);
+	if (channelID)
+		teardownChannels.push_back(channelID);
+	epicsMutexUnlock(teardownLock);
+	epicsEventSignal(teardownEvent);
+}
+
+// hand over user events of data object to caDispatchTask
+// data objects are queued once until dispatched, so posting always shows the latest values
+// CA callbacks return at once, posting inline is left for a full queue only
+//    item: data object with subscribers
+void queueEvent(calabItem* item) {
+	if (item->eventQueued.exchange(true)) {
+		item->eventsCoalesced.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+	if (dispatchQueue && dispatchQueue->push(item)) {
+		epicsEventSignal(dispatchEvent);
+		return;
+	}
+	item->eventQueued = false;
+	item->postEvent();
+}
+
+// remember LV user event held back by rate limit
+//    item: data object
+//    due: time of next token
+void deferEvent(calabItem* item, std::chrono::steady_clock::time_point due) {
+	if (!deferLock)
+		return;
+	epicsMutexLock(deferLock);
+	if (!item->eventDeferred) {
+		item->eventDeferred = true;
+		item->eventDue = due;
+		deferredEvents.push_back(item);
+	}
+	else if (due < item->eventDue) {
+		item->eventDue = due;
+	}
+	epicsMutexUnlock(deferLock);
+	epicsEventSignal(dispatchEvent);
+}
+
+// post LV user events held back by rate limits which are due
+//    returns time of next held back event
+std::chrono::steady_clock::time_point postDeferredEvents() {
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	std::chrono::steady_clock::time_point next = now + std::chrono::seconds(1);
+	std::vector<calabItem*> due;
+	epicsMutexLock(deferLock);
+	std::vector<calabItem*>::iterator it = deferredEvents.begin();
+	while (it != deferredEvents.end()) {
+		if ((*it)->eventDue <= now) {
+			(*it)->eventDeferred = false;
+			due.push_back(*it);
+			it = deferredEvents.erase(it);
+			continue;
+		}
+		if ((*it)->eventDue < next)
+			next = (*it)->eventDue;
+		++it;
+	}
+	epicsMutexUnlock(deferLock);
+	for (it = due.begin(); it != due.end(); ++it) {
+		if (valid(*it))
+			(*it)->postEvent(true);
+	}
+	return next;
+}
+
+// post batched user events which are due
+//    returns time of next due batch event
+std::chrono::steady_clock::time_point postBatchEvents() {
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	std::chrono::steady_clock::time_point next = now + std::chrono::seconds(1);
+	epicsMutexLock(batchLock);
+	std::vector<batchSubscriber*>::iterator it = batchSubscribers.begin();
+	while (it != batchSubscribers.end()) {
+		if ((*it)->due <= now) {
+			if (!(*it)->post()) {
+				delete *it;
+				it = batchSubscribers.erase(it);
+				continue;
+			}
+			(*it)->due += (*it)->period;
+			if ((*it)->due <= now)
+				(*it)->due = now + (*it)->period;
+		}
+		if ((*it)->due < next)
+			next = (*it)->due;
+		++it;
+	}
+	epicsMutexUnlock(batchLock);
+	return next;
+}
+
+// remove all subscribers of batched user events
+void clearBatchEvents() {
+	if (!batchLock)
+		return;
+	removeBatchEvents(0, true);
+	epicsMutexDestroy(batchLock);
+	batchLock = 0x0;
+}
+
+// Dispatch task
+// builds and posts LV user events of queued data objects and batched user events
+static void caDispatchTask(void) {
+	try {
+		tasks.fetch_add(1);
+		calabItem* item;
+		std::chrono::steady_clock::time_point next = std::chrono::steady_clock::now();
+		std::chrono::duration<double> wait;
+		while (!stopped) {
+			wait = next - std::chrono::steady_clock::now();
+			if (wait.count() > 0)
+				epicsEventWaitWithTimeout(dispatchEvent, wait.count());
+			while (!stopped && dispatchQueue->pop(item)) {
+				if (!valid(item))
+					continue;
+				// updates from now on queue the data object again
+				item->eventQueued = false;
+				item->postEvent();
+			}
+			if (!stopped) {
+				next = postBatchEvents();
+				next = std::min(next, postDeferredEvents());
+			}
+		}
+		tasks.fetch_sub(1);
+	}
+	catch (...) {
+		CaLabDbgPrintfD("exception in caDispatchTask");
+		tasks.fetch_sub(1);
+	}
+}
+
+// Put task
+// issues asynchronous puts of putValue in batches with one flush per batch
+// completion or failure of each put is posted as LV user event if requested
+static void caPutTask(void) {
+	try {
+		tasks.fetch_add(1);
+		std::vector<asyncPut*> batch;
+		asyncPut* job;
+		int32 iResult;
+		ca_attach_context(pcac);
+		while (!stopped) {
+			epicsEventWaitWithTimeout(putEvent, 1);
+			while (!stopped) {
+				batch.clear();
+				while (batch.size() < batchSize && putQueue->pop(job))
+					batch.push_back(job);
+				if (batch.empty())
+					break;
+				for (std::vector<asyncPut*>::iterator it = batch.begin(); it != batch.end(); ++it) {
+					job = *it;
+					if (!valid(job->item)) {
+						releasePut(job);
+						continue;
 					}
-					// disconnect field listeners
-					if (currentItem->parent) {
-						char* pIndicator;
-						pIndicator = strchr(currentItem->szName, '.');
-						if (pIndicator) {
-							int pos = (int)(strlen(currentItem->szName) - (pIndicator - currentItem->szName));
-							if (strncmp((const char*)(*currentItem->name)->str, (const char*)(*(**PvNameArray)->elt[i])->str, (*(**PvNameArray)->elt[i])->cnt - pos) == 0) {
-								currentItem->disconnect();
-							}
-						}
-						currentItem = currentItem->next;
+					// job leaves queue, newer puts of this PV are queued again
+					job->item->lock();
+					if (job->item->pendingPut == job)
+						job->item->pendingPut = 0x0;
+					job->item->unlock();
+					if (!job->item->caID || !*(((bool*)job->item->caID) + currentlyConnectedPos)) {
+						postPutResult(job, ECA_DISCONN);
+						releasePut(job);
 						continue;
 					}
-					// disconnect value listeners
-					if ((*(**PvNameArray)->elt[i])->cnt == (*currentItem->name)->cnt && strncmp((const char*)(*currentItem->name)->str, (const char*)(*(**PvNameArray)->elt[i])->str, (*(**PvNameArray)->elt[i])->cnt) == 0) {
-						currentItem->disconnect();
-						//CaLabDbgPrintfD("%s disconnected", currentItem->szName);
+					if (job->notify) {
+						iResult = ca_array_put_callback(job->type, job->count, job->item->caID, job->buffer, putDone, job);
+					}
+					else {
+						iResult = ca_array_put(job->type, job->count, job->item->caID, job->buffer);
 					}
-					currentItem = currentItem->next;
+					if (iResult == ECA_NORMAL)
+						job->item->putsSent.fetch_add(1, std::memory_order_relaxed);
+					if (job->notify && iResult == ECA_NORMAL)
+						continue;
+					postPutResult(job, iResult);
+					releasePut(job);
 				}
+				ca_flush_io();
 			}
-			myItems.unlock();
 		}
+		while (putQueue->pop(job))
+			releasePut(job);
+		ca_detach_context();
+		tasks.fetch_sub(1);
 	}
 	catch (...) {
-		CaLabDbgPrintfD("exception in disconnectPVs");
+		CaLabDbgPrintfD("exception in caPutTask");
+		tasks.fetch_sub(1);
+	}
+}
+
+// Teardown task
+// clears subscriptions and channels which are not needed anymore
+// runs beside caTask, so an unreachable server never blocks connecting other data objects
+static void caTeardownTask(void) {
+	try {
+		tasks.fetch_add(1);
+		std::deque<evid> events;
+		std::deque<chanId> channels;
+		ca_attach_context(pcac);
+		while (!stopped) {
+			epicsEventWaitWithTimeout(teardownEvent, 1);
+			if (stopped)
+				break;
+			epicsMutexLock(teardownLock);
+			events.swap(teardownEvents);
+			channels.swap(teardownChannels);
+			epicsMutexUnlock(teardownLock);
+			if (events.empty() && channels.empty())
+				continue;
+			for (std::deque<evid>::iterator it = events.begin(); it != events.end(); ++it)
+				ca_clear_subscription(*it);
+			for (std::deque<chanId>::iterator it = channels.begin(); it != channels.end(); ++it)
+				ca_clear_channel(*it);
+			ca_flush_io();
+			events.clear();
+			channels.clear();
+		}
+		ca_detach_context();
+		tasks.fetch_sub(1);
+	}
+	catch (...) {
+		CaLabDbgPrintfD("exception in caTeardownTask");
+		tasks.fetch_sub(1);
 	}
 }
 
 // Channel Access task
 // connects / reconnects / disconnects data objects to EPICS
+// sleeps until any job is posted (postJob) or a watch dog timer expires
 static void caTask(void) {
 	try {
 		tasks.fetch_add(1);
@@ -2941,36 +4754,62 @@ static void caTask(void) {
 		calabItem* currentItem;
 		uInt32 sizeOfCurrentList = 0;
 		uInt32 connectCounter = 0;
+		uInt32 pendingCounter = 0;
+		uInt32 batchCounter = 0;
+		uInt32 delay;
+		uInt32 currentJobs;
+		std::vector<std::pair<calabItem*, uInt32> > pendingJobs; // jobs taken from queue
+		bool changed;
+		double wait;
+		std::chrono::high_resolution_clock::time_point now;
+		std::multimap<std::chrono::high_resolution_clock::time_point, calabItem*> watchdogs; // reconnect timers
 		std::chrono::duration<double> diff;
 		ca_attach_context(pcac);
 		while (!stopped) {
-			if (myItems.numberOfItems == 0) {
-				epicsThreadSleep(.01);
-				continue;
+			wait = 1;
+			if (!watchdogs.empty()) {
+				diff = watchdogs.begin()->first - std::chrono::high_resolution_clock::now();
+				wait = diff.count() < 0 ? 0 : (diff.count() < 1 ? diff.count() : 1);
 			}
-			myItems.lock();
-			currentItem = myItems.firstItem;
-			myItems.unlock();
-			sizeOfCurrentList = 0;
-			connectCounter = 0;
-			while (currentItem) {
-				if (!valid(currentItem)) {
-					myItems.lock();
-					currentItem = myItems.firstItem;
-					myItems.unlock();
-					continue;
-				}
-				sizeOfCurrentList++;
-				// create channel identifier
-				if (!currentItem->caID) {
+			if (wait > 0)
+				epicsEventWaitWithTimeout(jobEvent, wait);
+			if (stopped)
+				break;
+			changed = false;
+			// take all posted jobs at once
+			epicsMutexLock(jobLock);
+			while (!jobQueue.empty()) {
+				currentItem = jobQueue.front();
+				jobQueue.pop_front();
+				currentJobs = currentItem->jobs.exchange(0);
+				if (currentJobs)
+					pendingJobs.push_back(std::make_pair(currentItem, currentJobs));
+			}
+			epicsMutexUnlock(jobLock);
+			changed = !pendingJobs.empty();
+			// first pass: create all channel identifiers, flush once
+			batchCounter = 0;
+			for (std::vector<std::pair<calabItem*, uInt32> >::iterator it = pendingJobs.begin(); it != pendingJobs.end(); ++it) {
+				currentItem = it->first;
+				if ((it->second & JOB_CREATE) && !currentItem->caID) {
 					currentItem->lock();
 					//CaLabDbgPrintfD("ca_create_channel for %s (number of channels %d)", currentItem->szName, myItems.numberOfItems.load());
 					iResult = ca_create_channel(currentItem->szName, connectionChanged, (void*)currentItem, 20, &currentItem->caID);
+					currentItem->timer = std::chrono::high_resolution_clock::now();
+					currentItem->channelCreated = std::chrono::steady_clock::now();
 					currentItem->unlock();
+					it->second |= JOB_WATCH;
+					batchCounter++;
 				}
-				else
-					// subscribe channel
-					if (!currentItem->isPassive && currentItem->isConnected && currentItem->caID && !currentItem->caEventID) {
+			}
+			if (batchCounter)
+				ca_flush_io();
+			// second pass: subscribe connected channels, flush after each batch
+			batchCounter = 0;
+			for (std::vector<std::pair<calabItem*, uInt32> >::iterator it = pendingJobs.begin(); it != pendingJobs.end(); ++it) {
+				currentItem = it->first;
+				if ((it->second & JOB_SUBSCRIBE) && !currentItem->isPassive && currentItem->caID) {
+					if (currentItem->isConnected && !currentItem->caEventID) {
 						currentItem->nativeType = ca_field_type(currentItem->caID);
 						if (currentItem->nativeType >= 0 && currentItem->nativeType < LAST_BUFFER_TYPE) {
 							currentItem->lock();
@@ -2981,49 +4820,111 @@ static void caTask(void) {
 								iResult = ca_create_subscription(DBR_CTRL_ENUM, 1, currentItem->caID, DBE_VALUE, valueChanged, (void*)currentItem, &currentItem->caEnumEventID);
 							}
 							currentItem->unlock();
+							if (++batchCounter >= batchSize) {
+								ca_flush_io();
+								batchCounter = 0;
+							}
 						}
 						else {
 							CaLabDbgPrintfD("%s skip create subscription because invalid native data type (%d)", currentItem->szName, currentItem->nativeType);
 						}
 					}
-					else {
-						// reconnect channel
-						if (!currentItem->isPassive && !currentItem->isConnected && !currentItem->caEventID) {
-							if (currentItem->parent && currentItem->parent->isConnected) {
-							}
-							else {
-								diff = std::chrono::high_resolution_clock::now() - currentItem->timer;
-								if (diff.count() > 10) {
-									currentItem->timer = std::chrono::high_resolution_clock::now();
-									if (currentItem->caID) {
-										iResult = ca_clear_channel(currentItem->caID);
-										if (iResult == ECA_NORMAL)
-											iResult = ca_pend_io(3);
-										if (iResult == ECA_NORMAL)
-											currentItem->caID = 0x0;
-									}
-									//currentItem->disconnect();
-									//DbgTime(); CaLabDbgPrintfD("repeat %s", currentItem->szName);
-								}
+					else if (!currentItem->isConnected) {
+						it->second |= JOB_WATCH;
+					}
+				}
+				// unsubscribe channel
+				if ((it->second & JOB_UNSUBSCRIBE) && currentItem->isPassive && currentItem->caEventID) {
+					postTeardown(currentItem->caEventID, 0x0);
+					currentItem->caEventID = 0x0;
+					currentItem->hasValue = false;
+				}
+				// read value once, callback is the same as for monitors
+				if ((it->second & JOB_GET) && currentItem->pollPending && currentItem->caID) {
+					if (currentItem->isConnected) {
+						currentItem->nativeType = ca_field_type(currentItem->caID);
+						if (currentItem->nativeType >= 0 && currentItem->nativeType < LAST_BUFFER_TYPE) {
+							currentItem->lock();
+							currentItem->pollPending = false;
+							if (currentItem->nativeType == DBF_ENUM && !currentItem->sEnum.no_str)
+								iResult = ca_array_get_callback(DBR_CTRL_ENUM, 1, currentItem->caID, valueChanged, (void*)currentItem);
+							iResult = ca_array_get_callback(dbf_type_to_DBR_TIME(currentItem->nativeType), ca_element_count(currentItem->caID), currentItem->caID, valueChanged, (void*)currentItem);
+							currentItem->unlock();
+							if (++batchCounter >= batchSize) {
+								ca_flush_io();
+								batchCounter = 0;
 							}
 						}
-						else {
-							connectCounter++;
-						}
 					}
-					// unsubscribe channel
-					if (currentItem->isPassive && currentItem->caEventID) {
-						iResult = ca_clear_subscription(currentItem->caEventID);
-						if (iResult == ECA_NORMAL)
-							iResult = ca_pend_io(3);
-						if (iResult == ECA_NORMAL)
-							currentItem->caEventID = 0x0;
-						currentItem->hasValue = false;
+					else {
+						it->second |= JOB_WATCH;
 					}
-					currentItem = currentItem->next;
+				}
+				// arm timer for reconnecting
+				if ((it->second & JOB_WATCH) && !currentItem->watchdog) {
+					currentItem->watchdog = true;
+					watchdogs.insert(std::make_pair(currentItem->timer + std::chrono::seconds(RECONNECT_DELAY), currentItem));
+				}
+			}
+			pendingJobs.clear();
+			// reconnect channels of expired timers
+			now = std::chrono::high_resolution_clock::now();
+			while (!watchdogs.empty() && watchdogs.begin()->first <= now) {
+				currentItem = watchdogs.begin()->second;
+				watchdogs.erase(watchdogs.begin());
+				currentItem->watchdog = false;
+				if (currentItem->isPassive || currentItem->isConnected || currentItem->caEventID || !currentItem->caID)
+					continue;
+				changed = true;
+				// remember missing channel and double delay of next attempt
+				currentItem->lock();
+				currentItem->isMissing = true;
+				currentItem->resolved();
+				currentItem->unlock();
+				// field of a connected PV is not recreated, its channel still connects by itself
+				if (currentItem->parent && currentItem->parent->isConnected)
+					continue;
+				currentItem->retryCount++;
+				delay = RECONNECT_DELAY;
+				for (uInt32 i = 1; i < currentItem->retryCount && delay < maxReconnectDelay; i++)
+					delay *= 2;
+				if (delay > maxReconnectDelay)
+					delay = maxReconnectDelay;
+				currentItem->timer = now;
+				// detach old channel from data object, late callbacks find no data object
+				ca_set_puser(currentItem->caID, 0x0);
+				postTeardown(0x0, currentItem->caID);
+				currentItem->caID = 0x0;
+				postJob(currentItem, JOB_CREATE);
+				//DbgTime(); CaLabDbgPrintfD("repeat %s", currentItem->szName);
+				currentItem->watchdog = true;
+				watchdogs.insert(std::make_pair(now + std::chrono::seconds(delay), currentItem));
+			}
+			if (!changed) {
+				if (flushRequested.exchange(false))
+					ca_flush_io();
+				continue;
 			}
-			//myItems.unlock();
+			flushRequested = false;
 			ca_flush_io();
+			// check connection state of all data objects
+			sizeOfCurrentList = 0;
+			connectCounter = 0;
+			pendingCounter = 0;
+			myItems.lock();
+			currentItem = myItems.firstItem;
+			while (currentItem) {
+				sizeOfCurrentList++;
+				if (currentItem->caID && currentItem->isConnected && (currentItem->isPassive || currentItem->caEventID))
+					connectCounter++;
+				if (!currentItem->isPassive && !currentItem->caEventID)
+					pendingCounter++;
+				currentItem = currentItem->next;
+			}
+			myItems.unlock();
+			progressTotal = sizeOfCurrentList;
+			progressConnected = connectCounter;
+			progressPending = pendingCounter;
 			if (sizeOfCurrentList > 0 && connectCounter == sizeOfCurrentList) {
 				allItemsConnected1 = true;
 			}
@@ -3034,7 +4935,6 @@ static void caTask(void) {
 			if (iResult != ECA_NORMAL) {
 				DbgTime(); CaLabDbgPrintfD("CA Task error (3): %s", ca_message(iResult));
 			}
-			epicsThreadSleep(.001);
 		}
 		ca_detach_context();
 		tasks.fetch_sub(1);
@@ -3044,6 +4944,19 @@ static void caTask(void) {
 	}
 }
 
+// Progress of connecting data objects (for example while CaLabInit.vi is running)
+//    Total: number of data objects (PVs and fields)
+//    Connected: number of data objects which are connected and subscribed
+//    Pending: number of active data objects which wait for connection or subscription
+extern "C" EXPORT void getConnectionProgress(uInt32 *Total, uInt32 *Connected, uInt32 *Pending) {
+	if (Total)
+		*Total = progressTotal;
+	if (Connected)
+		*Connected = progressConnected;
+	if (Pending)
+		*Pending = progressPending;
+}
+
 // Global counter for tests
 //   returns count of calls
 extern "C" EXPORT uInt32 getCounter() {
@@ -3056,6 +4969,7 @@ void loadFunctions() {
 	caLibHandle = dlopen("libca.so", RTLD_LAZY);
 	comLibHandle = dlopen("libCom.so", RTLD_LAZY);
 	ca_array_get = (ca_array_get_t)dlsym(caLibHandle, "ca_array_get");
+	ca_array_get_callback = (ca_array_get_callback_t)dlsym(caLibHandle, "ca_array_get_callback");
 	ca_add_exception_event = (ca_add_exception_event_t)dlsym(caLibHandle, "ca_add_exception_event");
 	ca_array_put = (ca_array_put_t)dlsym(caLibHandle, "ca_array_put");
 	ca_array_put_callback = (ca_array_put_callback_t)dlsym(caLibHandle, "ca_array_put_callback");
@@ -3075,10 +4989,17 @@ void loadFunctions() {
 	ca_name = (ca_name_t)dlsym(caLibHandle, "ca_name");
 	ca_pend_io = (ca_pend_io_t)dlsym(caLibHandle, "ca_pend_io");
 	ca_puser = (ca_puser_t)dlsym(caLibHandle, "ca_puser");
+	ca_set_puser = (ca_set_puser_t)dlsym(caLibHandle, "ca_set_puser");
 	ca_state = (ca_state_t)dlsym(caLibHandle, "ca_state");
 	dbr_value_offset = (dbr_value_offset_t)dlsym(caLibHandle, "dbr_value_offset");
 	envGetConfigParamPtr = (envGetConfigParamPtr_t)dlsym(comLibHandle, "envGetConfigParamPtr");
 	env_param_list = (env_param_list_t)dlsym(comLibHandle, "env_param_list");
+	epicsEventCreate = (epicsEventCreate_t)dlsym(comLibHandle, "epicsEventCreate");
+	epicsEventDestroy = (epicsEventDestroy_t)dlsym(comLibHandle, "epicsEventDestroy");
+	epicsEventSignal = (epicsEventSignal_t)dlsym(comLibHandle, "epicsEventTrigger");  // EPICS 3.15 and newer
+	if (!epicsEventSignal)
+		epicsEventSignal = (epicsEventSignal_t)dlsym(comLibHandle, "epicsEventSignal");
+	epicsEventWaitWithTimeout = (epicsEventWaitWithTimeout_t)dlsym(comLibHandle, "epicsEventWaitWithTimeout");
 	epicsMutexDestroy = (epicsMutexDestroy_t)dlsym(comLibHandle, "epicsMutexDestroy");
 	epicsMutexLock = (epicsMutexLock_t)dlsym(comLibHandle, "epicsMutexLock");
 	epicsMutexOsiCreate = (epicsMutexOsiCreate_t)dlsym(comLibHandle, "epicsMutexOsiCreate");
@@ -3108,6 +5029,27 @@ void caLabLoad(void) {
 	else {
 		bCaLabPolling = false;
 	}
+	if (getenv("CALAB_COALESCE_PUTS")) {
+		bCoalescePuts = true;
+	}
+	else {
+		bCoalescePuts = false;
+	}
+	if (getenv("CALAB_MAX_RECONNECT_DELAY")) {
+		maxReconnectDelay = (uInt32)strtoul(getenv("CALAB_MAX_RECONNECT_DELAY"), 0x0, 10);
+		if (maxReconnectDelay < RECONNECT_DELAY)
+			maxReconnectDelay = RECONNECT_DELAY;
+	}
+	if (getenv("CALAB_BATCH_SIZE")) {
+		batchSize = (uInt32)strtoul(getenv("CALAB_BATCH_SIZE"), 0x0, 10);
+		if (!batchSize)
+			batchSize = BATCH_SIZE;
+	}
+	if (getenv("CALAB_PUT_QUEUE_SIZE")) {
+		putQueueSize = (uInt32)strtoul(getenv("CALAB_PUT_QUEUE_SIZE"), 0x0, 10);
+		if (!putQueueSize)
+			putQueueSize = PUT_QUEUE_SIZE;
+	}
     // If c:/data/log exists assume we are an ISIS instrument and hide debug message window
 	if( !getenv("CALAB_NODBG") ) {
 		if ( access("c:/data/log", 0) == 0 ) {
@@ -3147,10 +5089,34 @@ void caLabLoad(void) {
 	}
 	pcac = ca_current_context();
 	ca_add_exception_event(exceptionCallback, NULL);
+	jobLock = epicsMutexCreate();
+	jobEvent = epicsEventCreate(epicsEventEmpty);
+	teardownLock = epicsMutexCreate();
+	teardownEvent = epicsEventCreate(epicsEventEmpty);
+	bufferLock = epicsMutexCreate();
+	deliveryLock = epicsMutexCreate();
+	putQueue = new boundedQueue<asyncPut*>(putQueueSize);
+	putEvent = epicsEventCreate(epicsEventEmpty);
+	dispatchQueue = new boundedQueue<calabItem*>(DISPATCH_QUEUE_SIZE);
+	dispatchEvent = epicsEventCreate(epicsEventEmpty);
+	batchLock = epicsMutexCreate();
+	deferLock = epicsMutexCreate();
 	epicsThreadCreate("caTask",
 		epicsThreadPriorityBaseMax,
 		epicsThreadGetStackSize(epicsThreadStackBig),
 		(EPICSTHREADFUNC)caTask, 0);
+	epicsThreadCreate("caTeardownTask",
+		epicsThreadPriorityBaseMax,
+		epicsThreadGetStackSize(epicsThreadStackBig),
+		(EPICSTHREADFUNC)caTeardownTask, 0);
+	epicsThreadCreate("caPutTask",
+		epicsThreadPriorityBaseMax,
+		epicsThreadGetStackSize(epicsThreadStackBig),
+		(EPICSTHREADFUNC)caPutTask, 0);
+	epicsThreadCreate("caDispatchTask",
+		epicsThreadPriorityBaseMax,
+		epicsThreadGetStackSize(epicsThreadStackBig),
+		(EPICSTHREADFUNC)caDispatchTask, 0);
 #ifdef _DEBUG
 	DbgTime(); CaLabDbgPrintfD("load CA Lab OK");
 #endif